@@ -19,8 +19,16 @@
  * SOFTWARE.
  */
 #pragma once
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <map>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #if !defined(SQLITE_OK)
@@ -188,6 +196,40 @@ namespace SQLT
         return static_cast<uint8_t>(l) == r;
     }
 
+    /**
+     * Enum for how SQLT::upsert() resolves rows that conflict with an existing row on the primary key.
+     */
+    enum class ConflictPolicy : uint8_t
+    {
+        IGNORE,  // INSERT OR IGNORE: Keep the existing row.
+        REPLACE, // INSERT OR REPLACE: Delete the existing row and insert the new one.
+        UPDATE   // INSERT ... ON CONFLICT(primary keys) DO UPDATE SET: Update the non-primary key columns of the existing row.
+    };
+
+    /**
+     * The order in which rows are inserted. When the keys are in random order, inserting in primary key order appends
+     * to the table B-tree instead of touching pages all over it, which keeps the working set small and is faster.
+     */
+    enum class InsertOrder : uint8_t
+    {
+        AS_GIVEN,   // In the order of the input.
+        PRIMARY_KEY // Sorted by the primary key columns. The input is not modified or copied, only pointers to it are sorted.
+    };
+
+    /**
+     * A row that SQLT::insertSkippingFailures() could not insert.
+     */
+    struct InsertFailure
+    {
+        InsertFailure(size_t index, int errorCode)
+            : index(index)
+            , errorCode(errorCode)
+        {}
+
+        size_t index;  // The index of the row in the inserted rows.
+        int errorCode; // The extended SQLite error code, e.g. SQLITE_CONSTRAINT_PRIMARYKEY.
+    };
+
     /**
      * SQLT Internal namespace. Should normally not be referenced externally.
      */
@@ -216,6 +258,11 @@ namespace SQLT
                 return (other.size() == size) && (other.compare(0, size, data) == 0);
             }
 
+            bool equals(const char *other, size_t otherSize) const
+            {
+                return (otherSize == size) && (std::char_traits<char>::compare(data, other, size) == 0);
+            }
+
             const char *data; // Not null-terminated
             size_t size;
         };
@@ -711,6 +758,15 @@ namespace SQLT
             }
         };
 
+        template<typename U1, typename U2>
+        struct MemberPointerComparer<bool, U1, bool, U2>
+        {
+            static inline bool compare(bool U1::* member1, bool U2::* member2)
+            {
+                return member1 == member2;
+            }
+        };
+
         template<typename U1, typename U2>
         struct MemberPointerComparer<SQLT::Nullable<int>, U1, SQLT::Nullable<int>, U2>
         {
@@ -738,13 +794,22 @@ namespace SQLT
             }
         };
 
+        template<typename U1, typename U2>
+        struct MemberPointerComparer<SQLT::Nullable<bool>, U1, SQLT::Nullable<bool>, U2>
+        {
+            static inline bool compare(SQLT::Nullable<bool> U1::* member1, SQLT::Nullable<bool> U2::* member2)
+            {
+                return member1 == member2;
+            }
+        };
+
         template<size_t INDEX, size_t SIZE, typename COL_TUPLE, typename T, typename U>
         struct ColumnTraverser_GetColumnName
         {
             static inline std::string traverse(const COL_TUPLE &columns, T U::* member)
             {
-                auto col = columns.template get<INDEX>();
-                if (MemberPointerComparer<typename decltype(col)::type, typename decltype(col)::classType, T, U>::compare(col.member, member))
+                const auto& col = columns.template get<INDEX>();
+                if (MemberPointerComparer<typename std::decay<decltype(col)>::type::type, typename std::decay<decltype(col)>::type::classType, T, U>::compare(col.member, member))
                     return col.name.toString();
                 return ColumnTraverser_GetColumnName<INDEX + 1, SIZE, COL_TUPLE, T, U>::traverse(columns, member);
             }
@@ -755,8 +820,8 @@ namespace SQLT
         {
             static inline std::string traverse(const COL_TUPLE &columns, T U::* member)
             {
-                auto col = columns.template get<INDEX>();
-                if (MemberPointerComparer<typename decltype(col)::type, typename decltype(col)::classType, T, U>::compare(col.member, member))
+                const auto& col = columns.template get<INDEX>();
+                if (MemberPointerComparer<typename std::decay<decltype(col)>::type::type, typename std::decay<decltype(col)>::type::classType, T, U>::compare(col.member, member))
                     return col.name.toString();
                 return "";
             }
@@ -765,8 +830,59 @@ namespace SQLT
         template<typename SQLT_TABLE, typename T, typename U>
         inline std::string getColumnName(T U::* member)
         {
-            auto columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
-            return ColumnTraverser_GetColumnName<0, decltype(columns)::size - 1, decltype(columns), T, U>::traverse(columns, member);
+            const auto& columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
+            typedef typename std::decay<decltype(columns)>::type COL_TUPLE;
+            return ColumnTraverser_GetColumnName<0, COL_TUPLE::size - 1, COL_TUPLE, T, U>::traverse(columns, member);
+        }
+
+        template<size_t INDEX, size_t SIZE, typename COL_TUPLE, typename T, typename U>
+        struct ColumnTraverser_GetColumnPosition
+        {
+            static inline size_t traverse(const COL_TUPLE &columns, T U::* member)
+            {
+                auto& col = columns.template get<INDEX>();
+                if (MemberPointerComparer<typename std::decay<decltype(col)>::type::type, typename std::decay<decltype(col)>::type::classType, T, U>::compare(col.member, member))
+                    return INDEX;
+                return ColumnTraverser_GetColumnPosition<INDEX + 1, SIZE, COL_TUPLE, T, U>::traverse(columns, member);
+            }
+        };
+
+        template<size_t INDEX, typename COL_TUPLE, typename T, typename U>
+        struct ColumnTraverser_GetColumnPosition<INDEX, INDEX, COL_TUPLE, T, U>
+        {
+            static inline size_t traverse(const COL_TUPLE &columns, T U::* member)
+            {
+                auto& col = columns.template get<INDEX>();
+                if (MemberPointerComparer<typename std::decay<decltype(col)>::type::type, typename std::decay<decltype(col)>::type::classType, T, U>::compare(col.member, member))
+                    return INDEX;
+                return -1; // Underflow on purpose
+            }
+        };
+
+        template<typename SQLT_TABLE, typename T, typename U>
+        inline size_t getColumnPosition(T U::* member)
+        {
+            const auto& columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
+            typedef typename std::decay<decltype(columns)>::type COL_TUPLE;
+            return ColumnTraverser_GetColumnPosition<0, COL_TUPLE::size - 1, COL_TUPLE, T, U>::traverse(columns, member);
+        }
+
+        template<typename SQLT_TABLE>
+        inline bool addColumnsToMask(size_t& /*mask*/)
+        {
+            return true;
+        }
+
+        // Sets bit n of mask for each member at column position n, see ColumnFilter::POSITION_MASK. Returns false if a
+        // member is not a column of SQLT_TABLE or its position does not fit in the mask.
+        template<typename SQLT_TABLE, typename T, typename... MEMBERS>
+        inline bool addColumnsToMask(size_t& mask, T SQLT_TABLE::* member, MEMBERS... members)
+        {
+            const size_t position = getColumnPosition<SQLT_TABLE>(member);
+            if (position >= sizeof(size_t) * 8)
+                return false;
+            mask |= size_t(1) << position;
+            return addColumnsToMask<SQLT_TABLE>(mask, members...);
         }
 
         template<size_t INDEX, typename COL_TUPLE>
@@ -796,8 +912,9 @@ namespace SQLT
         template<typename SQLT_TABLE>
         inline size_t getColumnInfoPosition(const std::string& colName)
         {
-            auto columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
-            return ColumnTraverser_GetColumnInfoPosition<decltype(columns)::size - 1, decltype(columns)>::traverse(columns, colName);
+            const auto& columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
+            typedef typename std::decay<decltype(columns)>::type COL_TUPLE;
+            return ColumnTraverser_GetColumnInfoPosition<COL_TUPLE::size - 1, COL_TUPLE>::traverse(columns, colName);
         }
 
         template<size_t INDEX, typename COL_TUPLE>
@@ -824,8 +941,49 @@ namespace SQLT
         template<typename SQLT_TABLE>
         inline size_t primaryKeyCount()
         {
-            auto columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
-            return ColumnTraverser_PrimaryKeyCount<decltype(columns)::size - 1, decltype(columns)>::traverse(columns);
+            const auto& columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
+            typedef typename std::decay<decltype(columns)>::type COL_TUPLE;
+            return ColumnTraverser_PrimaryKeyCount<COL_TUPLE::size - 1, COL_TUPLE>::traverse(columns);
+        }
+
+        template<size_t INDEX, typename COL_TUPLE>
+        struct ColumnTraverser_IntegerPrimaryKeyCount
+        {
+            static inline size_t traverse(const COL_TUPLE &columns)
+            {
+                auto& col = columns.template get<INDEX>();
+                typedef typename std::decay<decltype(col)>::type::type T;
+                size_t pk = (col.isPrimaryKey() && std::is_same<T, int>::value) ? 1 : 0;
+                return pk + ColumnTraverser_IntegerPrimaryKeyCount<INDEX - 1, COL_TUPLE>::traverse(columns);
+            }
+        };
+
+        template<typename COL_TUPLE>
+        struct ColumnTraverser_IntegerPrimaryKeyCount<0, COL_TUPLE>
+        {
+            static inline size_t traverse(const COL_TUPLE &columns)
+            {
+                auto& col = columns.template get<0>();
+                typedef typename std::decay<decltype(col)>::type::type T;
+                return (col.isPrimaryKey() && std::is_same<T, int>::value) ? 1 : 0;
+            }
+        };
+
+        // True if the table is declared with SQLT_TABLE_WITHOUT_ROWID or SQLT_TABLE_WITH_NAME_WITHOUT_ROWID.
+        template<typename SQLT_TABLE>
+        inline constexpr bool withoutRowid()
+        {
+            return SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_without_rowid();
+        }
+
+        // True if the primary key is a single int column of a rowid table, i.e. an alias for the rowid that SQLite can assign.
+        template<typename SQLT_TABLE>
+        inline bool hasIntegerPrimaryKey()
+        {
+            const auto& columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
+            typedef typename std::decay<decltype(columns)>::type COL_TUPLE;
+            return !withoutRowid<SQLT_TABLE>() && primaryKeyCount<SQLT_TABLE>() == 1 &&
+                   ColumnTraverser_IntegerPrimaryKeyCount<COL_TUPLE::size - 1, COL_TUPLE>::traverse(columns) == 1;
         }
 
         template<size_t INDEX, size_t SIZE, typename COL_TUPLE>
@@ -862,20 +1020,26 @@ namespace SQLT
             }
         };
 
+        // The SQL that only depends on the table is built on first use and kept in a function-local static, so the
+        // statement functions do no string building after that.
         template<typename SQLT_TABLE>
-        inline std::string createPrimaryKeyStatement()
+        inline const std::string& createPrimaryKeyStatement()
         {
-            std::string statement("");
-            size_t pkCount = primaryKeyCount<SQLT_TABLE>();
-            if (pkCount > 0)
-            {
-                statement += "PRIMARY KEY(";
-                size_t usedPks = 0;
-                auto columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
-                ColumnTraverser_CreateTablePrimaryKeys<0, decltype(columns)::size - 1, decltype(columns)>::traverse(columns, statement, pkCount, usedPks);
-                statement += ")";
-            }
-            return statement;
+            static const std::string sql = []() -> std::string {
+                std::string statement("");
+                size_t pkCount = primaryKeyCount<SQLT_TABLE>();
+                if (pkCount > 0)
+                {
+                    statement += "PRIMARY KEY(";
+                    size_t usedPks = 0;
+                    const auto& columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
+                    typedef typename std::decay<decltype(columns)>::type COL_TUPLE;
+                    ColumnTraverser_CreateTablePrimaryKeys<0, COL_TUPLE::size - 1, COL_TUPLE>::traverse(columns, statement, pkCount, usedPks);
+                    statement += ")";
+                }
+                return statement;
+            }();
+            return sql;
         }
 
         template<size_t INDEX, size_t SIZE, typename COL_TUPLE>
@@ -899,13 +1063,17 @@ namespace SQLT
             }
         };
 
-        template<typename COL_TUPLE>
-        inline std::string createTableContents()
-        {
-            std::string query;
-            auto columns = COL_TUPLE::template SQLTBase<COL_TUPLE>::sqlt_static_column_info();
-            ColumnTraverser_CreateTable<0, decltype(columns)::size - 1, decltype(columns)>::traverse(columns, query);
-            return query;
+        template<typename SQLT_TABLE>
+        inline const std::string& createTableContents()
+        {
+            static const std::string sql = []() -> std::string {
+                std::string query;
+                const auto& columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
+                typedef typename std::decay<decltype(columns)>::type COL_TUPLE;
+                ColumnTraverser_CreateTable<0, COL_TUPLE::size - 1, COL_TUPLE>::traverse(columns, query);
+                return query;
+            }();
+            return sql;
         }
 
         template<size_t INDEX, size_t SIZE, typename COL_TUPLE>
@@ -963,46 +1131,359 @@ namespace SQLT
             }
         };
 
+        enum class ColumnFilter : uint8_t
+        {
+            ALL,
+            PRIMARY_KEYS,
+            NON_PRIMARY_KEYS,
+            POSITION_MASK
+        };
+
+        // The columns a filtered traversal includes. ColumnFilter::POSITION_MASK includes the columns whose bit is set in
+        // mask, i.e. bit n for the column at position n. Converts implicitly from the other filters.
+        struct ColumnSelection
+        {
+            ColumnSelection(ColumnFilter filter, size_t mask = 0)
+                : filter(filter)
+                , mask(mask)
+            {}
+
+            bool includes(size_t position, bool isPrimaryKey) const
+            {
+                switch (filter)
+                {
+                    case ColumnFilter::ALL:              return true;
+                    case ColumnFilter::PRIMARY_KEYS:     return isPrimaryKey;
+                    case ColumnFilter::NON_PRIMARY_KEYS: return !isPrimaryKey;
+                    case ColumnFilter::POSITION_MASK:    return position < sizeof(size_t) * 8 && ((mask >> position) & 1) != 0;
+                }
+                return false;
+            }
+
+            ColumnFilter filter;
+            size_t mask;
+        };
+
+        // Appends pattern to query with every '$' replaced by the column name, e.g. "$=excluded.$".
+        inline void appendColumnPattern(std::string& query, const ColName& name, const char *pattern)
+        {
+            for (; *pattern; pattern++)
+            {
+                if (*pattern == '$')
+                    query.append(name.data, name.size);
+                else
+                    query += *pattern;
+            }
+        }
+
+        template<size_t INDEX, size_t SIZE, typename COL_TUPLE>
+        struct ColumnTraverser_CreateFilteredList
+        {
+            static inline void traverse(const COL_TUPLE &columns, std::string& query, const ColumnSelection& filter, const char *pattern, const char *separator, bool &empty)
+            {
+                ColumnTraverser_CreateFilteredList<INDEX, INDEX, COL_TUPLE>::traverse(columns, query, filter, pattern, separator, empty);
+                ColumnTraverser_CreateFilteredList<INDEX + 1, SIZE, COL_TUPLE>::traverse(columns, query, filter, pattern, separator, empty);
+            }
+        };
+
+        template<size_t INDEX, typename COL_TUPLE>
+        struct ColumnTraverser_CreateFilteredList<INDEX, INDEX, COL_TUPLE>
+        {
+            static inline void traverse(const COL_TUPLE &columns, std::string& query, const ColumnSelection& filter, const char *pattern, const char *separator, bool &empty)
+            {
+                auto& col = columns.template get<INDEX>();
+                if (!filter.includes(INDEX, col.isPrimaryKey()))
+                    return;
+                if (!empty)
+                    query += separator;
+                appendColumnPattern(query, col.name, pattern);
+                empty = false;
+            }
+        };
+
+        // Creates a list of the columns matching filter, each formatted by pattern (see appendColumnPattern) and separated by separator.
         template<typename SQLT_TABLE>
-        inline std::string createColumnNameList()
+        inline std::string createFilteredColumnList(const ColumnSelection& filter, const char *pattern, const char *separator)
         {
             std::string query;
-            auto columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
-            ColumnTraverser<0, decltype(columns)::size - 1, decltype(columns)>::createColumnNameList(columns, query);
+            bool empty = true;
+            const auto& columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
+            typedef typename std::decay<decltype(columns)>::type COL_TUPLE;
+            ColumnTraverser_CreateFilteredList<0, COL_TUPLE::size - 1, COL_TUPLE>::traverse(columns, query, filter, pattern, separator, empty);
             return query;
         }
 
+        // Three-way comparison of column values. NULL is lower than any value and equal to NULL.
+        template<typename T>
+        inline int compareValues(const T& a, const T& b)
+        {
+            return (a < b) ? -1 : ((b < a) ? 1 : 0);
+        }
+
+        template<typename T>
+        inline int compareValues(const SQLT::Nullable<T>& a, const SQLT::Nullable<T>& b)
+        {
+            if (a.is_null || b.is_null)
+                return (int)b.is_null - (int)a.is_null;
+            return compareValues(a.value, b.value);
+        }
+
+        template<size_t INDEX, size_t SIZE, typename COL_TUPLE, typename SQLT_TABLE>
+        struct ColumnTraverser_CompareRows
+        {
+            static inline int traverse(const COL_TUPLE &columns, const SQLT_TABLE& a, const SQLT_TABLE& b, const ColumnSelection& filter)
+            {
+                const int result = ColumnTraverser_CompareRows<INDEX, INDEX, COL_TUPLE, SQLT_TABLE>::traverse(columns, a, b, filter);
+                if (result != 0)
+                    return result;
+                return ColumnTraverser_CompareRows<INDEX + 1, SIZE, COL_TUPLE, SQLT_TABLE>::traverse(columns, a, b, filter);
+            }
+        };
+
+        template<size_t INDEX, typename COL_TUPLE, typename SQLT_TABLE>
+        struct ColumnTraverser_CompareRows<INDEX, INDEX, COL_TUPLE, SQLT_TABLE>
+        {
+            static inline int traverse(const COL_TUPLE &columns, const SQLT_TABLE& a, const SQLT_TABLE& b, const ColumnSelection& filter)
+            {
+                const auto& col = columns.template get<INDEX>();
+                if (!filter.includes(INDEX, col.isPrimaryKey()))
+                    return 0;
+                return compareValues(a.*col.member, b.*col.member);
+            }
+        };
+
+        // Compares the columns matching filter in column order, e.g. ColumnFilter::PRIMARY_KEYS to order rows by key.
         template<typename SQLT_TABLE>
-        inline std::string createColumnNameQuestionMarkList()
+        inline int compareRows(const SQLT_TABLE& a, const SQLT_TABLE& b, const ColumnSelection& filter)
         {
-            std::string query;
-            auto columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
-            ColumnTraverser<0, decltype(columns)::size - 1, decltype(columns)>::createColumnNameQuestionMarkList(columns, query);
-            return query;
+            const auto& columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
+            typedef typename std::decay<decltype(columns)>::type COL_TUPLE;
+            return ColumnTraverser_CompareRows<0, COL_TUPLE::size - 1, COL_TUPLE, SQLT_TABLE>::traverse(columns, a, b, filter);
+        }
+
+        template<typename SQLT_TABLE>
+        inline const std::string& createColumnNameList()
+        {
+            static const std::string sql = []() -> std::string {
+                std::string query;
+                const auto& columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
+                typedef typename std::decay<decltype(columns)>::type COL_TUPLE;
+                ColumnTraverser<0, COL_TUPLE::size - 1, COL_TUPLE>::createColumnNameList(columns, query);
+                return query;
+            }();
+            return sql;
+        }
+
+        template<typename SQLT_TABLE>
+        inline const std::string& createColumnNameQuestionMarkList()
+        {
+            static const std::string sql = []() -> std::string {
+                std::string query;
+                const auto& columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
+                typedef typename std::decay<decltype(columns)>::type COL_TUPLE;
+                ColumnTraverser<0, COL_TUPLE::size - 1, COL_TUPLE>::createColumnNameQuestionMarkList(columns, query);
+                return query;
+            }();
+            return sql;
+        }
+
+        template<typename SQLT_TABLE>
+        inline const std::string& createInsertPreparedStatement()
+        {
+            static const std::string sql = []() -> std::string {
+                std::string query = "INSERT INTO ";
+                auto tableName = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_table_name();
+                query += tableName.toString();
+
+                query += "(";
+                query += createColumnNameList<SQLT_TABLE>();
+                query += ") VALUES(";
+                query += createColumnNameQuestionMarkList<SQLT_TABLE>();
+                query += ");";
+
+                return query;
+            }();
+            return sql;
         }
 
+        // INSERT INTO table(col1,col2) VALUES(?,?),(?,?),...; with rowCount rows of parameters.
         template<typename SQLT_TABLE>
-        inline std::string createInsertPreparedStatement()
+        inline std::string createBatchedInsertPreparedStatement(size_t rowCount)
         {
             std::string query = "INSERT INTO ";
             auto tableName = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_table_name();
             query += tableName.toString();
 
+            query += "(";
+            query += createColumnNameList<SQLT_TABLE>();
+            query += ") VALUES";
+
+            const std::string questionMarks = "(" + createColumnNameQuestionMarkList<SQLT_TABLE>() + ")";
+            query.reserve(query.size() + rowCount * (questionMarks.size() + 1) + 1);
+            for (size_t i = 0; i < rowCount; i++)
+            {
+                if (i > 0)
+                    query += ",";
+                query += questionMarks;
+            }
+            query += ";";
+
+            return query;
+        }
+
+        // INSERT INTO table(non-pk columns) VALUES(?,...); which leaves the primary key to SQLite.
+        template<typename SQLT_TABLE>
+        inline const std::string& createInsertGeneratedKeyPreparedStatement()
+        {
+            static const std::string sql = []() -> std::string {
+                std::string query = "INSERT INTO ";
+                auto tableName = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_table_name();
+                query += tableName.toString();
+
+                const std::string columnList = createFilteredColumnList<SQLT_TABLE>(ColumnFilter::NON_PRIMARY_KEYS, "$", ",");
+                if (columnList.empty())
+                    return query + " DEFAULT VALUES;";
+
+                query += "(";
+                query += columnList;
+                query += ") VALUES(";
+                query += createFilteredColumnList<SQLT_TABLE>(ColumnFilter::NON_PRIMARY_KEYS, "?", ",");
+                query += ");";
+                return query;
+            }();
+            return sql;
+        }
+
+        // Expects the table to have at least one primary key column when policy is ConflictPolicy::UPDATE.
+        template<typename SQLT_TABLE>
+        inline std::string createUpsertPreparedStatement(ConflictPolicy policy)
+        {
+            std::string query;
+            switch (policy)
+            {
+                case ConflictPolicy::IGNORE:  query = "INSERT OR IGNORE INTO ";  break;
+                case ConflictPolicy::REPLACE: query = "INSERT OR REPLACE INTO "; break;
+                case ConflictPolicy::UPDATE:  query = "INSERT INTO ";            break;
+            }
+            auto tableName = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_table_name();
+            query += tableName.toString();
+
             query += "(";
             query += createColumnNameList<SQLT_TABLE>();
             query += ") VALUES(";
             query += createColumnNameQuestionMarkList<SQLT_TABLE>();
-            query += ");";
+            query += ")";
+
+            if (policy == ConflictPolicy::UPDATE)
+            {
+                query += " ON CONFLICT(";
+                query += createFilteredColumnList<SQLT_TABLE>(ColumnFilter::PRIMARY_KEYS, "$", ",");
+                query += ")";
+
+                const std::string assignments = createFilteredColumnList<SQLT_TABLE>(ColumnFilter::NON_PRIMARY_KEYS, "$=excluded.$", ",");
+                if (assignments.size())
+                    query += " DO UPDATE SET " + assignments;
+                else
+                    query += " DO NOTHING";
+            }
+            query += ";";
 
             return query;
         }
 
+        // UPDATE table SET col1=?,col2=? WHERE pk1=? AND pk2=?; with the columns to set bound first.
+        // Expects the table to have at least one primary key column and at least one column to set.
         template<typename SQLT_TABLE>
-        inline std::string createDeleteAllPreparedStatement()
+        inline std::string createUpdateColumnsPreparedStatement(const ColumnSelection& columns)
+        {
+            std::string query = "UPDATE ";
+            auto tableName = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_table_name();
+            query += tableName.toString();
+
+            query += " SET ";
+            query += createFilteredColumnList<SQLT_TABLE>(columns, "$=?", ",");
+            query += " WHERE ";
+            query += createFilteredColumnList<SQLT_TABLE>(ColumnFilter::PRIMARY_KEYS, "$=?", " AND ");
+            query += ";";
+            return query;
+        }
+
+        // Sets all non-primary key columns.
+        template<typename SQLT_TABLE>
+        inline const std::string& createUpdatePreparedStatement()
+        {
+            static const std::string sql = []() -> std::string {
+                return createUpdateColumnsPreparedStatement<SQLT_TABLE>(ColumnFilter::NON_PRIMARY_KEYS);
+            }();
+            return sql;
+        }
+
+        template<typename SQLT_TABLE>
+        inline const std::string& createDeleteAllPreparedStatement()
+        {
+            static const std::string sql = []() -> std::string {
+                std::string query = "DELETE FROM ";
+                auto tableName = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_table_name();
+                query += tableName.toString();
+                query += ";";
+                return query;
+            }();
+            return sql;
+        }
+
+        // DELETE FROM table WHERE pk IN (?,?,...); with keyCount keys, or for composite primary keys
+        // DELETE FROM table WHERE (pk1,pk2) IN (VALUES(?,?),(?,?),...);
+        template<typename SQLT_TABLE>
+        inline std::string createDeleteByKeysPreparedStatement(size_t keyCount)
         {
             std::string query = "DELETE FROM ";
             auto tableName = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_table_name();
             query += tableName.toString();
+
+            if (primaryKeyCount<SQLT_TABLE>() == 1)
+            {
+                query += " WHERE ";
+                query += createFilteredColumnList<SQLT_TABLE>(ColumnFilter::PRIMARY_KEYS, "$", ",");
+                query += " IN (";
+                for (size_t i = 0; i < keyCount; i++)
+                    query += (i == 0) ? "?" : ",?";
+                query += ");";
+                return query;
+            }
+
+            const std::string keyParameters = "(" + createFilteredColumnList<SQLT_TABLE>(ColumnFilter::PRIMARY_KEYS, "?", ",") + ")";
+            query += " WHERE (";
+            query += createFilteredColumnList<SQLT_TABLE>(ColumnFilter::PRIMARY_KEYS, "$", ",");
+            query += ") IN (VALUES";
+            for (size_t i = 0; i < keyCount; i++)
+            {
+                if (i > 0)
+                    query += ",";
+                query += keyParameters;
+            }
+            query += ");";
+            return query;
+        }
+
+        template<typename SQLT_TABLE>
+        inline const std::string& createSelectAllPreparedStatement()
+        {
+            static const std::string sql = []() -> std::string {
+                std::string query = "SELECT * FROM ";
+                auto tableName = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_table_name();
+                query += tableName.toString();
+                query += ";";
+                return query;
+            }();
+            return sql;
+        }
+
+        template<typename SQLT_TABLE>
+        inline std::string createSelectColumnPreparedStatement(const std::string& colName)
+        {
+            std::string query = "SELECT " + colName + " FROM ";
+            auto tableName = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_table_name();
+            query += tableName.toString();
             query += ";";
             return query;
         }
@@ -1010,13 +1491,16 @@ namespace SQLT
         template<typename SQLT_TABLE>
         inline size_t columnCount()
         {
-            auto columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
-            return ColumnTraverser<0, decltype(columns)::size - 1, decltype(columns)>::columnCount(columns);
+            const auto& columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
+            typedef typename std::decay<decltype(columns)>::type COL_TUPLE;
+            return ColumnTraverser<0, COL_TUPLE::size - 1, COL_TUPLE>::columnCount(columns);
         }
 
         template<typename T>
         struct SQLiteValueBinder
         {
+            typedef void Unsupported;
+
             static inline int bindValue(sqlite3_stmt *stmt, int index, T value)
             {
                 assert(false); // Missing bindValue() template specialization for column of type T.
@@ -1024,6 +1508,13 @@ namespace SQLT
             }
         };
 
+        // Whether T has a bindValue() template specialization.
+        template<typename T, typename = void>
+        struct HasValueBinder : std::true_type {};
+
+        template<typename T>
+        struct HasValueBinder<T, typename SQLiteValueBinder<T>::Unsupported> : std::false_type {};
+
         template<>
         struct SQLiteValueBinder<int>
         {
@@ -1051,6 +1542,26 @@ namespace SQLT
             }
         };
 
+        // Only used for query parameters, e.g. string literals passed to SQLT::params().
+        template<>
+        struct SQLiteValueBinder<const char*>
+        {
+            static inline int bindValue(sqlite3_stmt *stmt, int index, const char *value)
+            {
+                return sqlite3_bind_text(stmt, index, value, -1, SQLITE_STATIC);
+            }
+        };
+
+        // Only used for query parameters, e.g. rowids.
+        template<>
+        struct SQLiteValueBinder<int64_t>
+        {
+            static inline int bindValue(sqlite3_stmt *stmt, int index, int64_t value)
+            {
+                return sqlite3_bind_int64(stmt, index, (sqlite3_int64)value);
+            }
+        };
+
         // Fake bools to be an int type since SQLite does not have booleans.
         template<>
         struct SQLiteValueBinder<bool>
@@ -1110,30 +1621,124 @@ namespace SQLT
             return SQLiteValueBinder<T>::bindValue(stmt, index, row.*colInfo.member);
         }
 
-        template<typename T, typename U, typename SQLT_TABLE>
-        struct SQLiteMemberAssigner
+        // Sets the result of a virtual table column, the sqlite3_result_*() counterpart of SQLiteValueBinder.
+        template<typename T>
+        struct SQLiteValueResult
         {
-            static inline void assignMember(sqlite3_stmt *stmt, int index, SQLT_TABLE& row, T U::* memberPtr)
+            static inline void resultValue(sqlite3_context *context, const T& value)
             {
-                assert(false); // T is not a type that SQLite Tools can use. Must be int, double or std::string
+                assert(false); // Missing resultValue() template specialization for column of type T.
+                sqlite3_result_error_code(context, SQLITE_ERROR);
             }
         };
 
-        template<typename U, typename SQLT_TABLE>
-        struct SQLiteMemberAssigner<int, U, SQLT_TABLE>
+        template<>
+        struct SQLiteValueResult<int>
         {
-            static inline void assignMember(sqlite3_stmt *stmt, int index, SQLT_TABLE& row, int U::* memberPtr)
+            static inline void resultValue(sqlite3_context *context, int value)
             {
-                row.*memberPtr = sqlite3_column_int(stmt, index);
+                sqlite3_result_int(context, value);
             }
         };
 
-        template<typename U, typename SQLT_TABLE>
-        struct SQLiteMemberAssigner<double, U, SQLT_TABLE>
+        template<>
+        struct SQLiteValueResult<double>
         {
-            static inline void assignMember(sqlite3_stmt *stmt, int index, SQLT_TABLE& row, double U::* memberPtr)
+            static inline void resultValue(sqlite3_context *context, double value)
             {
-                row.*memberPtr = sqlite3_column_double(stmt, index);
+                sqlite3_result_double(context, value);
+            }
+        };
+
+        template<>
+        struct SQLiteValueResult<std::string>
+        {
+            static inline void resultValue(sqlite3_context *context, const std::string& value)
+            {
+                sqlite3_result_text(context, value.c_str(), (int)value.length(), SQLITE_STATIC);
+            }
+        };
+
+        // Fake bools to be an int type since SQLite does not have booleans.
+        template<>
+        struct SQLiteValueResult<bool>
+        {
+            static inline void resultValue(sqlite3_context *context, bool value)
+            {
+                sqlite3_result_int(context, value ? 1 : 0);
+            }
+        };
+
+        template<typename T>
+        struct SQLiteValueResult<SQLT::Nullable<T>>
+        {
+            static inline void resultValue(sqlite3_context *context, const SQLT::Nullable<T>& value)
+            {
+                if (value.is_null)
+                    sqlite3_result_null(context);
+                else
+                    SQLiteValueResult<T>::resultValue(context, value.value);
+            }
+        };
+
+        // Sets the result to the value of the column at position in row.
+        template<size_t INDEX, size_t SIZE, typename COL_TUPLE, typename SQLT_TABLE>
+        struct ColumnTraverser_ResultValue
+        {
+            static inline void traverse(const COL_TUPLE &columns, const SQLT_TABLE& row, sqlite3_context *context, size_t position)
+            {
+                if (position == INDEX)
+                    ColumnTraverser_ResultValue<INDEX, INDEX, COL_TUPLE, SQLT_TABLE>::traverse(columns, row, context, position);
+                else
+                    ColumnTraverser_ResultValue<INDEX + 1, SIZE, COL_TUPLE, SQLT_TABLE>::traverse(columns, row, context, position);
+            }
+        };
+
+        template<size_t INDEX, typename COL_TUPLE, typename SQLT_TABLE>
+        struct ColumnTraverser_ResultValue<INDEX, INDEX, COL_TUPLE, SQLT_TABLE>
+        {
+            static inline void traverse(const COL_TUPLE &columns, const SQLT_TABLE& row, sqlite3_context *context, size_t /*position*/)
+            {
+                const auto& col = columns.template get<INDEX>();
+                typedef typename std::decay<decltype(col)>::type::type T;
+                SQLiteValueResult<T>::resultValue(context, row.*col.member);
+            }
+        };
+
+        // Assigns a TEXT column by its byte count instead of its terminating zero, reusing the capacity of value.
+        inline void assignText(std::string& value, sqlite3_stmt *stmt, int index)
+        {
+            const char *text = (const char*)sqlite3_column_text(stmt, index);
+            if (text)
+                value.assign(text, (size_t)sqlite3_column_bytes(stmt, index));
+            else
+                value.clear();
+        }
+
+        template<typename T, typename U, typename SQLT_TABLE>
+        struct SQLiteMemberAssigner
+        {
+            static inline void assignMember(sqlite3_stmt *stmt, int index, SQLT_TABLE& row, T U::* memberPtr)
+            {
+                assert(false); // T is not a type that SQLite Tools can use. Must be int, double or std::string
+            }
+        };
+
+        template<typename U, typename SQLT_TABLE>
+        struct SQLiteMemberAssigner<int, U, SQLT_TABLE>
+        {
+            static inline void assignMember(sqlite3_stmt *stmt, int index, SQLT_TABLE& row, int U::* memberPtr)
+            {
+                row.*memberPtr = sqlite3_column_int(stmt, index);
+            }
+        };
+
+        template<typename U, typename SQLT_TABLE>
+        struct SQLiteMemberAssigner<double, U, SQLT_TABLE>
+        {
+            static inline void assignMember(sqlite3_stmt *stmt, int index, SQLT_TABLE& row, double U::* memberPtr)
+            {
+                row.*memberPtr = sqlite3_column_double(stmt, index);
             }
         };
 
@@ -1142,7 +1747,7 @@ namespace SQLT
         {
             static inline void assignMember(sqlite3_stmt *stmt, int index, SQLT_TABLE& row, std::string U::* memberPtr)
             {
-                row.*memberPtr = std::string((const char*)sqlite3_column_text(stmt, index));
+                assignText(row.*memberPtr, stmt, index);
             }
         };
 
@@ -1208,7 +1813,7 @@ namespace SQLT
                 {
                     assert(dataType == SQLITE_TEXT);
                     (row.*memberPtr).is_null = false;
-                    (row.*memberPtr).value = std::string((const char*)sqlite3_column_text(stmt, index));
+                    assignText((row.*memberPtr).value, stmt, index);
                 }
             }
         };
@@ -1280,7 +1885,17 @@ namespace SQLT
             static inline void assignValue(std::string& value, sqlite3_stmt *stmt)
             {
                 assert(sqlite3_column_type(stmt, 0) == SQLITE_TEXT);
-                value = std::string((const char*)sqlite3_column_text(stmt, 0));
+                assignText(value, stmt, 0);
+            }
+        };
+
+        template<>
+        struct SQLiteValueAssigner<bool>
+        {
+            static inline void assignValue(bool& value, sqlite3_stmt *stmt)
+            {
+                assert(sqlite3_column_type(stmt, 0) == SQLITE_INTEGER);
+                value = sqlite3_column_int(stmt, 0) != 0;
             }
         };
 
@@ -1324,7 +1939,22 @@ namespace SQLT
                 if (!value.is_null)
                 {
                     assert(dataType == SQLITE_TEXT);
-                    value.value = std::string((const char*)sqlite3_column_text(stmt, 0));
+                    assignText(value.value, stmt, 0);
+                }
+            }
+        };
+
+        template<>
+        struct SQLiteValueAssigner<SQLT::Nullable<bool>>
+        {
+            static inline void assignValue(SQLT::Nullable<bool>& value, sqlite3_stmt *stmt)
+            {
+                int dataType = sqlite3_column_type(stmt, 0);
+                value.is_null = (dataType == SQLITE_NULL);
+                if (!value.is_null)
+                {
+                    assert(dataType == SQLITE_INTEGER);
+                    value.value = sqlite3_column_int(stmt, 0) != 0;
                 }
             }
         };
@@ -1338,333 +1968,2647 @@ namespace SQLT
         template<size_t INDEX, size_t SIZE, typename COL_TUPLE, typename SQLT_TABLE>
         struct SQLiteColumnTraverser
         {
-            static inline int iterateAndBindValues(const COL_TUPLE& columns, const SQLT_TABLE& row, sqlite3_stmt *stmt)
+            static inline int iterateAndBindValues(const COL_TUPLE& columns, const SQLT_TABLE& row, sqlite3_stmt *stmt, int offset)
             {
-                int result = bindValue(columns.template get<INDEX>(), row, stmt, (int)INDEX + 1); // SQLite binds are 1-indexed
+                int result = bindValue(columns.template get<INDEX>(), row, stmt, offset + (int)INDEX + 1); // SQLite binds are 1-indexed
                 if (result != SQLITE_OK)
                     return result;
-                return SQLiteColumnTraverser<INDEX + 1, SIZE, COL_TUPLE, SQLT_TABLE>::iterateAndBindValues(columns, row, stmt);
+                return SQLiteColumnTraverser<INDEX + 1, SIZE, COL_TUPLE, SQLT_TABLE>::iterateAndBindValues(columns, row, stmt, offset);
             }
 
-            static inline void iterateAndAssignMembers(const COL_TUPLE& columns, SQLT_TABLE& row, sqlite3_stmt *stmt)
+            static inline int iterateAndBindFilteredValues(const COL_TUPLE& columns, const SQLT_TABLE& row, sqlite3_stmt *stmt, const ColumnSelection& filter, int& index)
             {
-                assignMember(columns.template get<INDEX>(), row, stmt, (int)INDEX);
-                SQLiteColumnTraverser<INDEX + 1, SIZE, COL_TUPLE, SQLT_TABLE>::iterateAndAssignMembers(columns, row, stmt);
+                int result = SQLiteColumnTraverser<INDEX, INDEX, COL_TUPLE, SQLT_TABLE>::iterateAndBindFilteredValues(columns, row, stmt, filter, index);
+                if (result != SQLITE_OK)
+                    return result;
+                return SQLiteColumnTraverser<INDEX + 1, SIZE, COL_TUPLE, SQLT_TABLE>::iterateAndBindFilteredValues(columns, row, stmt, filter, index);
             }
 
-            static inline bool iterateAndAssignMembersByColumnName(const COL_TUPLE& columns, SQLT_TABLE& row, sqlite3_stmt *stmt, const char* const colName, int colIndex)
+            static inline void iterateAndAssignMembers(const COL_TUPLE& columns, SQLT_TABLE& row, sqlite3_stmt *stmt)
             {
-                auto colInfo = columns.template get<INDEX>();
-                if (colInfo.name == colName)
-                {
-                    assignMember(colInfo, row, stmt, colIndex);
-                    return true;
-                }
-                return SQLiteColumnTraverser<INDEX + 1, SIZE, COL_TUPLE, SQLT_TABLE>::iterateAndAssignMembersByColumnName(columns, row, stmt, colName, colIndex);
+                assignMember(columns.template get<INDEX>(), row, stmt, (int)INDEX);
+                SQLiteColumnTraverser<INDEX + 1, SIZE, COL_TUPLE, SQLT_TABLE>::iterateAndAssignMembers(columns, row, stmt);
             }
         };
 
         template<size_t INDEX, typename COL_TUPLE, typename SQLT_TABLE>
         struct SQLiteColumnTraverser<INDEX, INDEX, COL_TUPLE, SQLT_TABLE>
         {
-            static inline int iterateAndBindValues(const COL_TUPLE& columns, const SQLT_TABLE& row, sqlite3_stmt *stmt)
+            static inline int iterateAndBindValues(const COL_TUPLE& columns, const SQLT_TABLE& row, sqlite3_stmt *stmt, int offset)
             {
-                return bindValue(columns.template get<INDEX>(), row, stmt, (int)INDEX + 1); // SQLite binds are 1-indexed
+                return bindValue(columns.template get<INDEX>(), row, stmt, offset + (int)INDEX + 1); // SQLite binds are 1-indexed
             }
 
-            static inline void iterateAndAssignMembers(const COL_TUPLE& columns, SQLT_TABLE& row, sqlite3_stmt *stmt)
+            static inline int iterateAndBindFilteredValues(const COL_TUPLE& columns, const SQLT_TABLE& row, sqlite3_stmt *stmt, const ColumnSelection& filter, int& index)
             {
-                assignMember(columns.template get<INDEX>(), row, stmt, (int)INDEX);
+                const auto& colInfo = columns.template get<INDEX>();
+                if (!filter.includes(INDEX, colInfo.isPrimaryKey()))
+                    return SQLITE_OK;
+                return bindValue(colInfo, row, stmt, ++index);
             }
 
-            static inline bool iterateAndAssignMembersByColumnName(const COL_TUPLE& columns, SQLT_TABLE& row, sqlite3_stmt *stmt, const char* const colName, int colIndex)
+            static inline void iterateAndAssignMembers(const COL_TUPLE& columns, SQLT_TABLE& row, sqlite3_stmt *stmt)
             {
-                auto colInfo = columns.template get<INDEX>();
-                if (colInfo.name == colName)
-                {
-                    assignMember(colInfo, row, stmt, colIndex);
-                    return true;
-                }
-                return false;
+                assignMember(columns.template get<INDEX>(), row, stmt, (int)INDEX);
             }
         };
 
         template<typename SQLT_TABLE>
-        inline int iterateAndBindValues(const SQLT_TABLE& row, sqlite3_stmt *stmt)
+        inline int iterateAndBindValues(const SQLT_TABLE& row, sqlite3_stmt *stmt, int offset = 0)
         {
-            auto columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
-            return SQLiteColumnTraverser<0, decltype(columns)::size - 1, decltype(columns), SQLT_TABLE>::iterateAndBindValues(columns, row, stmt);
+            // By reference, copying the column info would copy the default values of std::string columns.
+            const auto& columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
+            typedef typename std::decay<decltype(columns)>::type COL_TUPLE;
+            return SQLiteColumnTraverser<0, COL_TUPLE::size - 1, COL_TUPLE, SQLT_TABLE>::iterateAndBindValues(columns, row, stmt, offset);
         }
 
+        // Binds the columns matching filter to consecutive parameters, starting after offset.
         template<typename SQLT_TABLE>
-        inline void iterateAndAssignMembers(SQLT_TABLE& row, sqlite3_stmt *stmt)
+        inline int iterateAndBindFilteredValues(const SQLT_TABLE& row, sqlite3_stmt *stmt, const ColumnSelection& filter, int offset = 0)
         {
-            auto columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
-            SQLiteColumnTraverser<0, decltype(columns)::size - 1, decltype(columns), SQLT_TABLE>::iterateAndAssignMembers(columns, row, stmt);
+            const auto& columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
+            typedef typename std::decay<decltype(columns)>::type COL_TUPLE;
+            return SQLiteColumnTraverser<0, COL_TUPLE::size - 1, COL_TUPLE, SQLT_TABLE>::iterateAndBindFilteredValues(columns, row, stmt, filter, offset);
         }
 
-        template<typename SQLT_QUERY_STRUCT>
-        inline void iterateAndAssignMembersByColumnName(SQLT_QUERY_STRUCT& row, sqlite3_stmt *stmt, const char* const colName, int colIndex)
+        template<typename SQLT_TABLE>
+        inline void iterateAndAssignMembers(SQLT_TABLE& row, sqlite3_stmt *stmt)
         {
-            auto columns = SQLT_QUERY_STRUCT::template SQLTBase<SQLT_QUERY_STRUCT>::sqlt_static_column_info();
-            SQLiteColumnTraverser<0, decltype(columns)::size - 1, decltype(columns), SQLT_QUERY_STRUCT>::iterateAndAssignMembersByColumnName(columns, row, stmt, colName, colIndex);
+            const auto& columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
+            typedef typename std::decay<decltype(columns)>::type COL_TUPLE;
+            SQLiteColumnTraverser<0, COL_TUPLE::size - 1, COL_TUPLE, SQLT_TABLE>::iterateAndAssignMembers(columns, row, stmt);
         }
-    } // End namespace Internal
 
-    /**
-     * Get the table name for an SQLT table struct.
-     *
-     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
-     * @return The table name for the SQLT table struct template parameter.
-     */
-    template<typename SQLT_TABLE>
-    inline std::string tableName()
-    {
-        auto tableName = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_table_name();
-        return tableName.toString();
-    }
+        // Assigns a result column to a member of a query struct. Resolved once per statement from the result column names.
+        template<typename SQLT_QUERY_STRUCT>
+        using ColumnAssigner = void (*)(SQLT_QUERY_STRUCT& row, sqlite3_stmt *stmt, int colIndex);
 
-    /**
-     * Create a table if it does not already exist.
-     *
-     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
-     * @param db The sqlite3 instance to create the table in.
-     * @param errMsg The sqlite3 message output.
-     * @return The SQLite error code. Will be SQLITE_OK if the table was successfully created or if it already existed.
-     *
-     * @see SQLT::createAllTables(sqlite3 *db, char **errMsg)
-     * @see SQLT::createAllTables(char **errMsg)
-     */
-    template<typename SQLT_TABLE>
-    inline int createTableIfNotExists(sqlite3 *db, char **errMsg)
-    {
-        std::string query = std::string("CREATE TABLE IF NOT EXISTS ") + tableName<SQLT_TABLE>();
-        query += "(";
-        query += SQLT::Internal::createTableContents<SQLT_TABLE>();
-        size_t pkCount = SQLT::Internal::primaryKeyCount<SQLT_TABLE>();
-        if (pkCount > 0)
+        template<size_t INDEX, typename SQLT_QUERY_STRUCT>
+        inline void assignColumn(SQLT_QUERY_STRUCT& row, sqlite3_stmt *stmt, int colIndex)
         {
-            query += ",";
-            query += SQLT::Internal::createPrimaryKeyStatement<SQLT_TABLE>();
+            const auto& columns = SQLT_QUERY_STRUCT::template SQLTBase<SQLT_QUERY_STRUCT>::sqlt_static_column_info();
+            assignMember(columns.template get<INDEX>(), row, stmt, colIndex);
         }
-        query += ");";
-        return sqlite3_exec(db, query.c_str(), NULL, NULL, errMsg);
-    }
-
-    /**
-     * Drop a table if it exists.
-     *
-     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
-     * @param db The sqlite3 instance to drop the table in.
-     * @param errMsg The sqlite3 message output.
-     * @return The SQLite error code. Will be SQLITE_OK if the table was successfully dropped or if it did not exist.
-     *
-     * @see SQLT::createAllTables(sqlite3 *db, char **errMsg)
-     * @see SQLT::createAllTables(char **errMsg)
-     */
-    template<typename SQLT_TABLE>
-    inline int dropTableIfExists(sqlite3 *db, char **errMsg)
-    {
-        std::string stmt = std::string("DROP TABLE IF EXISTS ") + tableName<SQLT_TABLE>() + ";";
-        return sqlite3_exec(db, stmt.c_str(), NULL, NULL, errMsg);
-    }
 
-    /**
-     * Insert rows into a table.
-     *
-     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
-     * @param db The sqlite3 instance to drop the table in.
-     * @param rows The rows to insert into the database.
-     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully inserted.
-     *
-     * @see SQLT::insert(sqlite3 *db, const SQLT_TABLE& row)
-     * @see SQLT::insert(const std::vector<SQLT_TABLE>& rows)
-     * @see SQLT::insert(const SQLT_TABLE& row)
-     */
-    template<typename SQLT_TABLE>
-    inline int insert(sqlite3 *db, const std::vector<SQLT_TABLE>& rows)
-    {
-        int result;
-        sqlite3_stmt *stmt;
-        const std::string preparedStatement = SQLT::Internal::createInsertPreparedStatement<SQLT_TABLE>();
+        // Returns the assigner of the first member named colName, or nullptr if there is none.
+        template<size_t INDEX, size_t SIZE, typename COL_TUPLE, typename SQLT_QUERY_STRUCT>
+        struct ColumnTraverser_FindAssigner
+        {
+            static inline ColumnAssigner<SQLT_QUERY_STRUCT> traverse(const COL_TUPLE& columns, const char *colName, size_t colNameSize)
+            {
+                const ColumnAssigner<SQLT_QUERY_STRUCT> assigner = ColumnTraverser_FindAssigner<INDEX, INDEX, COL_TUPLE, SQLT_QUERY_STRUCT>::traverse(columns, colName, colNameSize);
+                if (assigner)
+                    return assigner;
+                return ColumnTraverser_FindAssigner<INDEX + 1, SIZE, COL_TUPLE, SQLT_QUERY_STRUCT>::traverse(columns, colName, colNameSize);
+            }
+        };
 
-        result = sqlite3_prepare_v2(db, preparedStatement.c_str(), -1, &stmt, NULL);
-        if (result != SQLITE_OK)
-            return result;
+        template<size_t INDEX, typename COL_TUPLE, typename SQLT_QUERY_STRUCT>
+        struct ColumnTraverser_FindAssigner<INDEX, INDEX, COL_TUPLE, SQLT_QUERY_STRUCT>
+        {
+            static inline ColumnAssigner<SQLT_QUERY_STRUCT> traverse(const COL_TUPLE& columns, const char *colName, size_t colNameSize)
+            {
+                return columns.template get<INDEX>().name.equals(colName, colNameSize) ? &assignColumn<INDEX, SQLT_QUERY_STRUCT> : nullptr;
+            }
+        };
 
-        for (auto const& r : rows)
+        // One assigner per result column of the prepared statement, nullptr for the result columns without a member.
+        template<typename SQLT_QUERY_STRUCT>
+        inline std::vector<ColumnAssigner<SQLT_QUERY_STRUCT>> resolveColumnAssigners(sqlite3_stmt *stmt)
         {
-            sqlite3_reset(stmt);
-            result = SQLT::Internal::iterateAndBindValues<SQLT_TABLE>(r, stmt);
-            if (result != SQLITE_OK)
-                return result;
+            const auto& columns = SQLT_QUERY_STRUCT::template SQLTBase<SQLT_QUERY_STRUCT>::sqlt_static_column_info();
+            typedef typename std::decay<decltype(columns)>::type COL_TUPLE;
 
-            result = sqlite3_step(stmt);
-            if (result != SQLITE_DONE)
+            const int count = sqlite3_column_count(stmt);
+            std::vector<ColumnAssigner<SQLT_QUERY_STRUCT>> assigners((size_t)count);
+            for (int colIndex = 0; colIndex < count; colIndex++)
             {
-                sqlite3_finalize(stmt);
-                return result;
+                const char* const colName = sqlite3_column_name(stmt, colIndex);
+                if (colName)
+                    assigners[colIndex] = ColumnTraverser_FindAssigner<0, COL_TUPLE::size - 1, COL_TUPLE, SQLT_QUERY_STRUCT>::traverse(columns, colName, std::char_traits<char>::length(colName));
             }
+            return assigners;
         }
 
-        result = sqlite3_finalize(stmt);
-        return result;
-    }
+        // Steps a custom query and appends a row to output for each result row, assigning the members by the result column
+        // names. Members without a result column are value-initialized. The statement is not finalized or reset.
+        template<typename SQLT_QUERY_STRUCT>
+        inline int selectQueryRows(sqlite3_stmt *stmt, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count)
+        {
+            if (output->size() < approximate_row_count)
+                output->reserve(approximate_row_count);
 
-    /**
-     * Insert a single row into a table.
-     *
-     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
-     * @param db The sqlite3 instance to drop the table in.
-     * @param row The row to insert into the database.
-     * @return The SQLite error code. Will be SQLITE_OK if the row was successfully inserted.
-     *
-     * @see SQLT::insert(sqlite3 *db, const std::vector<SQLT_TABLE>& rows)
-     * @see SQLT::insert(const std::vector<SQLT_TABLE>& rows)
-     * @see SQLT::insert(const SQLT_TABLE& row)
-     */
-    template<typename SQLT_TABLE>
-    inline int insert(sqlite3 *db, const SQLT_TABLE& row)
-    {
-        return SQLT::insert(db, std::vector<SQLT_TABLE>({row}));
-    }
+            const std::vector<ColumnAssigner<SQLT_QUERY_STRUCT>> assigners = resolveColumnAssigners<SQLT_QUERY_STRUCT>(stmt);
+            const int count = (int)assigners.size();
 
-    /**
-     * Insert rows into a table.
-     *
-     * @tparam SQLT_DB The database to insert into, defined by SQLT_DATABASE, SQLT_DATABASE_WITH_NAME or SQLT_DATABASE_WITH_NAME_AND_PATH.
-     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
-     * @param rows The rows to insert into the database.
-     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully inserted.
-     *
-     * @see SQLT::insert(sqlite3 *db, const std::vector<SQLT_TABLE>& rows)
-     * @see SQLT::insert(sqlite3 *db, const SQLT_TABLE& row)
-     * @see SQLT::insert(const SQLT_TABLE& row)
-     */
-    template<typename SQLT_DB, typename SQLT_TABLE>
-    inline int insert(const std::vector<SQLT_TABLE>& rows)
-    {
-        int result;
-        sqlite3 *db;
-        auto dbInfo = SQLT_DB::template SQLTDatabase<SQLT_DB>::sqlt_static_database_info();
+            while (true)
+            {
+                int result = sqlite3_step(stmt);
+                if (result == SQLITE_ROW)
+                {
+                    if (count == 0)
+                        continue;
 
-        result = sqlite3_open(dbInfo.dbFilePath().c_str(), &db);
-        if (result != SQLITE_OK)
-        {
-            sqlite3_close(db);
-            return result;
+                    output->emplace_back();
+                    SQLT_QUERY_STRUCT& row = output->back();
+                    for (int colIndex = 0; colIndex < count; colIndex++)
+                    {
+                        if (assigners[colIndex])
+                            assigners[colIndex](row, stmt, colIndex);
+                    }
+                }
+                else if (result == SQLITE_DONE)
+                {
+                    return SQLITE_OK;
+                }
+                else
+                {
+                    return result;
+                }
+            }
         }
 
-        result = SQLT::insert<SQLT_TABLE>(db, rows);
-
-        if (result != SQLITE_OK)
+        // Steps a custom query and passes each result row to callback, decoded into the same struct, until the callback
+        // returns false. The statement is not finalized or reset.
+        template<typename SQLT_QUERY_STRUCT, typename ROW_CALLBACK>
+        inline int forEachQueryRow(sqlite3_stmt *stmt, ROW_CALLBACK& callback)
         {
-            sqlite3_close(db);
-            return result;
-        }
+            const std::vector<ColumnAssigner<SQLT_QUERY_STRUCT>> assigners = resolveColumnAssigners<SQLT_QUERY_STRUCT>(stmt);
+            const int count = (int)assigners.size();
 
-        return sqlite3_close(db);
-    }
+            SQLT_QUERY_STRUCT row;
+            while (true)
+            {
+                int result = sqlite3_step(stmt);
+                if (result == SQLITE_ROW)
+                {
+                    for (int colIndex = 0; colIndex < count; colIndex++)
+                    {
+                        if (assigners[colIndex])
+                            assigners[colIndex](row, stmt, colIndex);
+                    }
 
-    /**
-     * Insert a single row into a table.
-     *
-     * @tparam SQLT_DB The database to insert into, defined by SQLT_DATABASE, SQLT_DATABASE_WITH_NAME or SQLT_DATABASE_WITH_NAME_AND_PATH.
+                    if (!callback(row))
+                        return SQLITE_OK;
+                }
+                else if (result == SQLITE_DONE)
+                {
+                    return SQLITE_OK;
+                }
+                else
+                {
+                    return result;
+                }
+            }
+        }
+
+        // The parameters of a custom query, created by SQLT::params(). Holds references to the arguments, so it must be
+        // used in the same expression as it is created in.
+        template<typename... ARGS>
+        struct Parameters
+        {
+            explicit Parameters(const ARGS&... args)
+                : values(args...)
+            {}
+
+            std::tuple<const ARGS&...> values;
+        };
+
+        // The type a query parameter of type T is bound as. Integers other than int and bool are bound as int64_t, and
+        // floating point numbers as double.
+        template<typename T, typename = void>
+        struct ParameterType
+        {
+            typedef T type;
+        };
+
+        template<typename T>
+        struct ParameterType<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, int>::value && !std::is_same<T, bool>::value>::type>
+        {
+            typedef int64_t type;
+        };
+
+        template<typename T>
+        struct ParameterType<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+        {
+            typedef double type;
+        };
+
+        // Binds the parameters to ?1, ?2, ... in order through SQLiteValueBinder.
+        template<size_t INDEX, size_t SIZE, typename TUPLE>
+        struct ParameterTraverser
+        {
+            static inline int bind(sqlite3_stmt *stmt, const TUPLE& values)
+            {
+                typedef typename ParameterType<typename std::decay<typename std::tuple_element<INDEX, TUPLE>::type>::type>::type T;
+                static_assert(HasValueBinder<T>::value, "Query parameters must be of a column type, const char*, an integer or a floating point type.");
+                const int result = SQLiteValueBinder<T>::bindValue(stmt, (int)INDEX + 1, std::get<INDEX>(values));
+                if (result != SQLITE_OK)
+                    return result;
+                return ParameterTraverser<INDEX + 1, SIZE, TUPLE>::bind(stmt, values);
+            }
+        };
+
+        template<size_t SIZE, typename TUPLE>
+        struct ParameterTraverser<SIZE, SIZE, TUPLE>
+        {
+            static inline int bind(sqlite3_stmt *, const TUPLE&)
+            {
+                return SQLITE_OK;
+            }
+        };
+
+        template<typename... ARGS>
+        inline int bindParameters(sqlite3_stmt *stmt, const Parameters<ARGS...>& parameters)
+        {
+            typedef std::tuple<const ARGS&...> TUPLE;
+            return ParameterTraverser<0, sizeof...(ARGS), TUPLE>::bind(stmt, parameters.values);
+        }
+
+        enum class StatementKind : uint8_t
+        {
+            INSERT,
+            INSERT_BATCH,
+            UPSERT,
+            SELECT_ALL,
+            SELECT_COLUMN,
+            DELETE_ALL,
+            UPDATE,
+            UPDATE_COLUMNS
+        };
+
+        // Returns an address that is unique for each SQLT table struct. Used to key cached statements by table type.
+        template<typename SQLT_TABLE>
+        inline const void *tableKey()
+        {
+            static const char key = 0;
+            return &key;
+        }
+
+        struct StatementKey
+        {
+            StatementKey(const void *table, StatementKind kind, size_t variant = 0)
+                : table(table)
+                , kind(kind)
+                , variant(variant)
+            {}
+
+            bool operator<(const StatementKey& other) const
+            {
+                if (table != other.table)
+                    return std::less<const void*>()(table, other.table);
+                if (kind != other.kind)
+                    return kind < other.kind;
+                return variant < other.variant;
+            }
+
+            const void *table;
+            StatementKind kind;
+            size_t variant; // Distinguishes statements of the same kind on the same table, e.g. the column for StatementKind::SELECT_COLUMN.
+        };
+
+        // Rows can be passed by value, by pointer or by std::reference_wrapper. RowType<V>::type is the SQLT table struct
+        // and rowReference() gives access to the row without copying it.
+        template<typename V>
+        struct RowType
+        {
+            typedef V type;
+        };
+
+        template<typename V>
+        struct RowType<V*>
+        {
+            typedef typename std::remove_const<V>::type type;
+        };
+
+        template<typename V>
+        struct RowType<std::reference_wrapper<V>>
+        {
+            typedef typename std::remove_const<V>::type type;
+        };
+
+        template<typename SQLT_TABLE>
+        inline const SQLT_TABLE& rowReference(const SQLT_TABLE& row)
+        {
+            return row;
+        }
+
+        template<typename SQLT_TABLE>
+        inline const SQLT_TABLE& rowReference(SQLT_TABLE *row)
+        {
+            return *row;
+        }
+
+        template<typename SQLT_TABLE>
+        inline const SQLT_TABLE& rowReference(const std::reference_wrapper<SQLT_TABLE>& row)
+        {
+            return row.get();
+        }
+
+        template<typename ITERATOR>
+        struct IteratorRowType
+        {
+            typedef typename RowType<typename std::iterator_traits<ITERATOR>::value_type>::type type;
+        };
+
+        template<typename SQLT_TABLE>
+        inline int insertRow(sqlite3_stmt *stmt, const SQLT_TABLE& row)
+        {
+            sqlite3_reset(stmt);
+            int result = SQLT::Internal::iterateAndBindValues(row, stmt);
+            if (result != SQLITE_OK)
+                return result;
+
+            result = sqlite3_step(stmt);
+            return (result == SQLITE_DONE) ? SQLITE_OK : result;
+        }
+
+        template<typename ITERATOR>
+        inline int insertRows(sqlite3_stmt *stmt, ITERATOR first, ITERATOR last)
+        {
+            int result;
+            for (; first != last; ++first)
+            {
+                result = SQLT::Internal::insertRow(stmt, SQLT::Internal::rowReference(*first));
+                if (result != SQLITE_OK)
+                    return result;
+            }
+            return SQLITE_OK;
+        }
+
+        // Inserts rowsPerStatement rows per step using a statement from createBatchedInsertPreparedStatement(rowsPerStatement).
+        // The distance between first and last must be a multiple of rowsPerStatement.
+        template<typename ITERATOR>
+        inline int insertRowsBatched(sqlite3_stmt *stmt, size_t rowsPerStatement, int columnsPerRow, ITERATOR first, ITERATOR last)
+        {
+            int result;
+            while (first != last)
+            {
+                sqlite3_reset(stmt);
+                for (size_t i = 0; i < rowsPerStatement; i++, ++first)
+                {
+                    result = SQLT::Internal::iterateAndBindValues(SQLT::Internal::rowReference(*first), stmt, (int)i * columnsPerRow);
+                    if (result != SQLITE_OK)
+                        return result;
+                }
+
+                result = sqlite3_step(stmt);
+                if (result != SQLITE_DONE)
+                    return result;
+            }
+            return SQLITE_OK;
+        }
+
+        // Binds the columns to set of each row followed by its primary key columns, see createUpdateColumnsPreparedStatement().
+        template<typename ITERATOR>
+        inline int updateRows(sqlite3_stmt *stmt, const ColumnSelection& columns, int keyOffset, ITERATOR first, ITERATOR last, int64_t *changes)
+        {
+            int result;
+            sqlite3 *db = sqlite3_db_handle(stmt);
+            for (; first != last; ++first)
+            {
+                const auto& row = SQLT::Internal::rowReference(*first);
+                sqlite3_reset(stmt);
+                result = SQLT::Internal::iterateAndBindFilteredValues(row, stmt, columns);
+                if (result == SQLITE_OK)
+                    result = SQLT::Internal::iterateAndBindFilteredValues(row, stmt, ColumnFilter::PRIMARY_KEYS, keyOffset);
+                if (result != SQLITE_OK)
+                    return result;
+
+                result = sqlite3_step(stmt);
+                if (result != SQLITE_DONE)
+                    return result;
+                *changes += sqlite3_changes(db);
+            }
+            return SQLITE_OK;
+        }
+
+        // Number of rows that fit in one batched INSERT statement given the SQLITE_LIMIT_VARIABLE_NUMBER limit of the connection.
+        template<typename SQLT_TABLE>
+        inline size_t batchedInsertRowCount(sqlite3 *db, size_t maxRowsPerStatement)
+        {
+            const size_t variableLimit = (size_t)sqlite3_limit(db, SQLITE_LIMIT_VARIABLE_NUMBER, -1);
+            size_t rowCount = variableLimit / columnCount<SQLT_TABLE>();
+            if (maxRowsPerStatement > 0 && maxRowsPerStatement < rowCount)
+                rowCount = maxRowsPerStatement;
+            return rowCount > 0 ? rowCount : 1;
+        }
+
+        // Pointers to the rows ordered by primary key, so the rows can be inserted in key order without being copied.
+        template<typename SQLT_TABLE>
+        inline std::vector<const SQLT_TABLE*> sortByPrimaryKey(const std::vector<SQLT_TABLE>& rows)
+        {
+            std::vector<const SQLT_TABLE*> sorted;
+            sorted.reserve(rows.size());
+            for (const auto& row : rows)
+                sorted.push_back(&row);
+            std::stable_sort(sorted.begin(), sorted.end(), [](const SQLT_TABLE *a, const SQLT_TABLE *b) {
+                return compareRows(*a, *b, ColumnFilter::PRIMARY_KEYS) < 0;
+            });
+            return sorted;
+        }
+
+        // Eponymous virtual table sqlt_vector_<table> that reads the rows of a std::vector<SQLT_TABLE>. The vector is passed
+        // with sqlite3_bind_pointer() as the argument of the table-valued function, e.g. SELECT * FROM sqlt_vector_table(?),
+        // and the index of each row is its rowid.
+        template<typename SQLT_TABLE>
+        struct VectorTable
+        {
+            struct Cursor
+            {
+                sqlite3_vtab_cursor base;
+                const std::vector<SQLT_TABLE> *rows;
+                size_t index;
+            };
+
+            // The type of the bound pointer, per table, so that sqlite3_value_pointer() only accepts a vector of SQLT_TABLE.
+            static const char *pointerType()
+            {
+                static const std::string type = moduleName();
+                return type.c_str();
+            }
+
+            static std::string moduleName()
+            {
+                return "sqlt_vector_" + SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_table_name().toString();
+            }
+
+            static int connect(sqlite3 *db, void *, int, const char *const *, sqlite3_vtab **vtab, char **)
+            {
+                const std::string schema = "CREATE TABLE x(" + createColumnNameList<SQLT_TABLE>() + ",sqlt_rows HIDDEN);";
+                int result = sqlite3_declare_vtab(db, schema.c_str());
+                if (result != SQLITE_OK)
+                    return result;
+
+                *vtab = static_cast<sqlite3_vtab*>(sqlite3_malloc(sizeof(sqlite3_vtab)));
+                if (*vtab == nullptr)
+                    return SQLITE_NOMEM;
+                **vtab = sqlite3_vtab();
+                return SQLITE_OK;
+            }
+
+            static int disconnect(sqlite3_vtab *vtab)
+            {
+                sqlite3_free(vtab);
+                return SQLITE_OK;
+            }
+
+            // Without the rows argument the table is empty.
+            static int bestIndex(sqlite3_vtab *, sqlite3_index_info *info)
+            {
+                const int rowsColumn = (int)columnCount<SQLT_TABLE>();
+                info->idxNum = 0;
+                info->estimatedCost = 1e99;
+                for (int i = 0; i < info->nConstraint; i++)
+                {
+                    const auto& constraint = info->aConstraint[i];
+                    if (constraint.iColumn == rowsColumn && constraint.op == SQLITE_INDEX_CONSTRAINT_EQ && constraint.usable)
+                    {
+                        info->aConstraintUsage[i].argvIndex = 1;
+                        info->aConstraintUsage[i].omit = 1;
+                        info->idxNum = 1;
+                        info->estimatedCost = 1;
+                        break;
+                    }
+                }
+                return SQLITE_OK;
+            }
+
+            static int open(sqlite3_vtab *, sqlite3_vtab_cursor **cursor)
+            {
+                Cursor *vectorCursor = static_cast<Cursor*>(sqlite3_malloc(sizeof(Cursor)));
+                if (vectorCursor == nullptr)
+                    return SQLITE_NOMEM;
+                *vectorCursor = Cursor();
+                *cursor = &vectorCursor->base;
+                return SQLITE_OK;
+            }
+
+            static int close(sqlite3_vtab_cursor *cursor)
+            {
+                sqlite3_free(cursor);
+                return SQLITE_OK;
+            }
+
+            static int filter(sqlite3_vtab_cursor *cursor, int idxNum, const char *, int argc, sqlite3_value **argv)
+            {
+                Cursor *vectorCursor = reinterpret_cast<Cursor*>(cursor);
+                vectorCursor->rows = (idxNum == 1 && argc == 1) ? static_cast<const std::vector<SQLT_TABLE>*>(sqlite3_value_pointer(argv[0], pointerType())) : nullptr;
+                vectorCursor->index = 0;
+                return SQLITE_OK;
+            }
+
+            static int next(sqlite3_vtab_cursor *cursor)
+            {
+                reinterpret_cast<Cursor*>(cursor)->index++;
+                return SQLITE_OK;
+            }
+
+            static int eof(sqlite3_vtab_cursor *cursor)
+            {
+                const Cursor *vectorCursor = reinterpret_cast<Cursor*>(cursor);
+                return (vectorCursor->rows == nullptr || vectorCursor->index >= vectorCursor->rows->size()) ? 1 : 0;
+            }
+
+            static int column(sqlite3_vtab_cursor *cursor, sqlite3_context *context, int position)
+            {
+                const Cursor *vectorCursor = reinterpret_cast<Cursor*>(cursor);
+                const auto& columns = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_column_info();
+                typedef typename std::decay<decltype(columns)>::type COL_TUPLE;
+                if (position < (int)COL_TUPLE::size)
+                    ColumnTraverser_ResultValue<0, COL_TUPLE::size - 1, COL_TUPLE, SQLT_TABLE>::traverse(columns, (*vectorCursor->rows)[vectorCursor->index], context, (size_t)position);
+                else
+                    sqlite3_result_null(context);
+                return SQLITE_OK;
+            }
+
+            static int rowid(sqlite3_vtab_cursor *cursor, sqlite3_int64 *rowid)
+            {
+                *rowid = (sqlite3_int64)reinterpret_cast<Cursor*>(cursor)->index;
+                return SQLITE_OK;
+            }
+
+            // Whether the last error on db is that the module is not registered on it, e.g. rather than a missing table to
+            // insert into.
+            static bool isModuleMissing(sqlite3 *db)
+            {
+                static const std::string message = "no such table: " + moduleName();
+                return message == sqlite3_errmsg(db);
+            }
+
+            // Registers the module on the connection. Without xCreate it is an eponymous-only virtual table.
+            static int registerModule(sqlite3 *db)
+            {
+                static const sqlite3_module module = {
+                    0,           // iVersion
+                    nullptr,     // xCreate
+                    &connect,    // xConnect
+                    &bestIndex,  // xBestIndex
+                    &disconnect, // xDisconnect
+                    nullptr,     // xDestroy
+                    &open,       // xOpen
+                    &close,      // xClose
+                    &filter,     // xFilter
+                    &next,       // xNext
+                    &eof,        // xEof
+                    &column,     // xColumn
+                    &rowid,      // xRowid
+                    nullptr,     // xUpdate
+                    nullptr,     // xBegin
+                    nullptr,     // xSync
+                    nullptr,     // xCommit
+                    nullptr,     // xRollback
+                    nullptr,     // xFindFunction
+                    nullptr,     // xRename
+                    nullptr,     // xSavepoint
+                    nullptr,     // xRelease
+                    nullptr      // xRollbackTo
+                };
+                return sqlite3_create_module_v2(db, moduleName().c_str(), &module, nullptr, nullptr);
+            }
+        };
+
+        // INSERT INTO table(col1,col2) SELECT col1,col2 FROM sqlt_vector_table(?);
+        template<typename SQLT_TABLE>
+        inline const std::string& createVirtualTableInsertPreparedStatement()
+        {
+            static const std::string sql = []() -> std::string {
+                const std::string columnList = createColumnNameList<SQLT_TABLE>();
+                std::string query = "INSERT INTO ";
+                query += SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_table_name().toString();
+                query += "(" + columnList + ") SELECT " + columnList + " FROM ";
+                query += VectorTable<SQLT_TABLE>::moduleName();
+                query += "(?);";
+                return query;
+            }();
+            return sql;
+        }
+
+        // Inserts [first, last) with a full-size batched statement followed by one sized to the remainder.
+        template<typename SQLT_TABLE, typename ITERATOR>
+        inline int insertBatched(sqlite3 *db, ITERATOR first, ITERATOR last, size_t maxRowsPerStatement)
+        {
+            int result;
+            sqlite3_stmt *stmt;
+            const int columnsPerRow = (int)columnCount<SQLT_TABLE>();
+            const size_t batchRowCount = batchedInsertRowCount<SQLT_TABLE>(db, maxRowsPerStatement);
+            const size_t tailRowCount = (size_t)(last - first) % batchRowCount;
+            const ITERATOR tailBegin = last - tailRowCount;
+
+            if (first != tailBegin)
+            {
+                const std::string preparedStatement = createBatchedInsertPreparedStatement<SQLT_TABLE>(batchRowCount);
+                result = sqlite3_prepare_v2(db, preparedStatement.c_str(), -1, &stmt, NULL);
+                if (result != SQLITE_OK)
+                    return result;
+
+                result = insertRowsBatched(stmt, batchRowCount, columnsPerRow, first, tailBegin);
+                if (result != SQLITE_OK)
+                {
+                    sqlite3_finalize(stmt);
+                    return result;
+                }
+
+                result = sqlite3_finalize(stmt);
+                if (result != SQLITE_OK)
+                    return result;
+            }
+
+            if (tailRowCount > 0)
+            {
+                const std::string preparedStatement = createBatchedInsertPreparedStatement<SQLT_TABLE>(tailRowCount);
+                result = sqlite3_prepare_v2(db, preparedStatement.c_str(), -1, &stmt, NULL);
+                if (result != SQLITE_OK)
+                    return result;
+
+                result = insertRowsBatched(stmt, tailRowCount, columnsPerRow, tailBegin, last);
+                if (result != SQLITE_OK)
+                {
+                    sqlite3_finalize(stmt);
+                    return result;
+                }
+
+                return sqlite3_finalize(stmt);
+            }
+
+            return SQLITE_OK;
+        }
+
+        // A savepoint acts as BEGIN/COMMIT outside of a transaction and nests inside an open transaction.
+        inline int beginSavepoint(sqlite3 *db, const char *name)
+        {
+            const std::string statement = std::string("SAVEPOINT ") + name + ";";
+            return sqlite3_exec(db, statement.c_str(), NULL, NULL, NULL);
+        }
+
+        // Releases the savepoint, after rolling back the changes made since beginSavepoint() unless commit is set.
+        inline int endSavepoint(sqlite3 *db, const char *name, bool commit)
+        {
+            if (!commit)
+            {
+                const std::string rollback = std::string("ROLLBACK TO ") + name + ";";
+                sqlite3_exec(db, rollback.c_str(), NULL, NULL, NULL);
+            }
+            const std::string release = std::string("RELEASE ") + name + ";";
+            return sqlite3_exec(db, release.c_str(), NULL, NULL, NULL);
+        }
+
+        // True for errors that only concern the row being inserted. SQLite has undone the failed statement, so the
+        // transaction can continue with the next row.
+        inline bool isRowError(int result)
+        {
+            const int primaryResult = result & 0xff;
+            return primaryResult == SQLITE_CONSTRAINT || primaryResult == SQLITE_MISMATCH ||
+                   primaryResult == SQLITE_TOOBIG || primaryResult == SQLITE_RANGE;
+        }
+
+        // Inserts the rows with an INSERT statement in a savepoint, recording the rows that fail with a row error instead
+        // of stopping. Any other error rolls back the savepoint.
+        template<typename SQLT_TABLE>
+        inline int insertRowsSkippingFailures(sqlite3 *db, sqlite3_stmt *stmt, const std::vector<SQLT_TABLE>& rows,
+                                              std::vector<InsertFailure> *failures, size_t *insertedRows)
+        {
+            size_t inserted = 0;
+            int result = beginSavepoint(db, "sqlt_insert_skipping_failures");
+            if (result != SQLITE_OK)
+                return result;
+
+            for (size_t i = 0; i < rows.size(); i++)
+            {
+                result = insertRow(stmt, rows[i]);
+                if (result == SQLITE_OK)
+                {
+                    inserted++;
+                }
+                else if (isRowError(result))
+                {
+                    failures->push_back(InsertFailure(i, sqlite3_extended_errcode(db)));
+                    result = SQLITE_OK;
+                }
+                else
+                {
+                    break;
+                }
+            }
+            sqlite3_reset(stmt);
+
+            const int savepointResult = endSavepoint(db, "sqlt_insert_skipping_failures", result == SQLITE_OK);
+            if (result == SQLITE_OK)
+                result = savepointResult;
+            if (insertedRows)
+                *insertedRows = (result == SQLITE_OK) ? inserted : 0;
+            return result;
+        }
+
+        // Deletes keyCount keys in statements of up to maxKeysPerStatement keys, limited by SQLITE_LIMIT_VARIABLE_NUMBER.
+        // bindKey(stmt, keyIndex, offset) binds the primary key column(s) of key keyIndex to the parameters after offset.
+        template<typename SQLT_TABLE, typename KEY_BINDER>
+        inline int deleteKeys(sqlite3 *db, size_t keyCount, size_t maxKeysPerStatement, KEY_BINDER bindKey, int64_t *deleted)
+        {
+            const size_t pkCount = primaryKeyCount<SQLT_TABLE>();
+            const size_t variableLimit = (size_t)sqlite3_limit(db, SQLITE_LIMIT_VARIABLE_NUMBER, -1);
+            const size_t keysPerStatement = std::max<size_t>(1, std::min(maxKeysPerStatement, variableLimit / pkCount));
+
+            int result = SQLITE_OK;
+            sqlite3_stmt *stmt = nullptr;
+            size_t statementKeys = 0;
+            for (size_t done = 0; done < keyCount && result == SQLITE_OK; done += statementKeys)
+            {
+                const size_t count = std::min(keysPerStatement, keyCount - done);
+                if (!stmt || count != statementKeys)
+                {
+                    sqlite3_finalize(stmt);
+                    const std::string preparedStatement = createDeleteByKeysPreparedStatement<SQLT_TABLE>(count);
+                    result = sqlite3_prepare_v2(db, preparedStatement.c_str(), -1, &stmt, NULL);
+                    if (result != SQLITE_OK)
+                    {
+                        stmt = nullptr;
+                        break;
+                    }
+                    statementKeys = count;
+                }
+
+                sqlite3_reset(stmt);
+                for (size_t i = 0; i < count && result == SQLITE_OK; i++)
+                    result = bindKey(stmt, done + i, (int)(i * pkCount));
+                if (result != SQLITE_OK)
+                    break;
+
+                result = sqlite3_step(stmt);
+                if (result == SQLITE_DONE)
+                {
+                    result = SQLITE_OK;
+                    *deleted += sqlite3_changes(db);
+                }
+            }
+
+            sqlite3_finalize(stmt);
+            return result;
+        }
+
+        template<typename SQLT_TABLE>
+        inline int selectAllRows(sqlite3_stmt *stmt, std::vector<SQLT_TABLE> *output, size_t approximate_row_count)
+        {
+            int result;
+            if (output->size() < approximate_row_count)
+                output->reserve(approximate_row_count);
+
+            while (true)
+            {
+                result = sqlite3_step(stmt);
+                if (result == SQLITE_ROW)
+                {
+                    output->emplace_back();
+                    SQLT::Internal::iterateAndAssignMembers(output->back(), stmt);
+                }
+                else if (result == SQLITE_DONE)
+                {
+                    return SQLITE_OK;
+                }
+                else
+                {
+                    return result;
+                }
+            }
+        }
+
+        template<typename SQLT_TABLE, typename ROW_CALLBACK>
+        inline int forEachTableRow(sqlite3_stmt *stmt, ROW_CALLBACK& callback)
+        {
+            int result;
+            SQLT_TABLE row;
+            while (true)
+            {
+                result = sqlite3_step(stmt);
+                if (result == SQLITE_ROW)
+                {
+                    SQLT::Internal::iterateAndAssignMembers(row, stmt);
+                    if (!callback(row))
+                        return SQLITE_OK;
+                }
+                else if (result == SQLITE_DONE)
+                {
+                    return SQLITE_OK;
+                }
+                else
+                {
+                    return result;
+                }
+            }
+        }
+
+        // Steps a SELECT of all columns and overwrites the rows of output in order. A row is decoded into a scratch row
+        // and swapped in only if it differs, so the string buffers of both are reused. Rows are only appended or erased at
+        // the end of output.
+        template<typename SQLT_TABLE>
+        inline int selectAllRowsInto(sqlite3_stmt *stmt, std::vector<SQLT_TABLE> *output, size_t *changedRows)
+        {
+            size_t count = 0;
+            size_t changed = 0;
+            SQLT_TABLE scratch;
+            while (true)
+            {
+                int result = sqlite3_step(stmt);
+                if (result == SQLITE_ROW)
+                {
+                    if (count < output->size())
+                    {
+                        SQLT::Internal::iterateAndAssignMembers(scratch, stmt);
+                        SQLT_TABLE& row = (*output)[count];
+                        if (SQLT::Internal::compareRows(scratch, row, ColumnFilter::ALL) != 0)
+                        {
+                            std::swap(scratch, row);
+                            changed++;
+                        }
+                    }
+                    else
+                    {
+                        output->emplace_back();
+                        SQLT::Internal::iterateAndAssignMembers(output->back(), stmt);
+                        changed++;
+                    }
+                    count++;
+                }
+                else if (result == SQLITE_DONE)
+                {
+                    changed += output->size() - count;
+                    output->erase(output->begin() + count, output->end());
+                    if (changedRows)
+                        *changedRows = changed;
+                    return SQLITE_OK;
+                }
+                else
+                {
+                    return result;
+                }
+            }
+        }
+
+        template<typename T>
+        inline int selectColumnValues(sqlite3_stmt *stmt, std::vector<T> *output, size_t approximate_row_count)
+        {
+            int result;
+            if (output->size() < approximate_row_count)
+                output->reserve(approximate_row_count);
+
+            T selectedValue;
+            while (true)
+            {
+                result = sqlite3_step(stmt);
+                if (result == SQLITE_ROW)
+                {
+                    SQLT::Internal::assignValue(selectedValue, stmt);
+                    output->emplace_back(std::move(selectedValue));
+                }
+                else if (result == SQLITE_DONE)
+                {
+                    return SQLITE_OK;
+                }
+                else
+                {
+                    return result;
+                }
+            }
+        }
+    } // End namespace Internal
+
+    /**
+     * A cache of prepared statements belonging to a single sqlite3 connection.
+     *
+     * Statements are keyed by the SQLT table struct they operate on and are only prepared the first time they are used.
+     * The SQLT functions taking a StatementCache instead of an sqlite3 instance reuse the cached statement by calling
+     * sqlite3_reset() and sqlite3_clear_bindings(), which avoids building the SQL string and calling sqlite3_prepare_v2()
+     * on every call.
+     *
+     * The cache finalizes its statements when it is destroyed or cleared. This must happen before the sqlite3 connection
+     * is closed, since sqlite3_close() fails with SQLITE_BUSY as long as there are unfinalized statements.
+     */
+    class StatementCache
+    {
+    public:
+        explicit StatementCache(sqlite3 *db)
+            : database(db)
+            , hitCount(0)
+            , missCount(0)
+        {}
+
+        ~StatementCache()
+        {
+            clear();
+        }
+
+        StatementCache(const StatementCache&) = delete;
+        StatementCache& operator=(const StatementCache&) = delete;
+
+        /// The sqlite3 instance the statements are prepared for.
+        sqlite3 *db() const { return database; }
+
+        /// Number of times a statement was found in the cache.
+        size_t hits() const { return hitCount; }
+
+        /// Number of times a statement had to be prepared.
+        size_t misses() const { return missCount; }
+
+        /**
+         * Get a prepared statement from the cache, or prepare and cache it if it does not exist. The statement is reset
+         * and its bindings are cleared before it is returned. The returned statement is owned by the cache and must not be
+         * finalized by the caller.
+         *
+         * @param key The key to look the statement up by.
+         * @param createStatement Callable returning the SQL string for the statement. Only called on cache misses.
+         * @param stmt The prepared statement output.
+         * @return The SQLite error code. Will be SQLITE_OK if the statement was found or successfully prepared.
+         */
+        template<typename SQL_FACTORY>
+        int prepare(const Internal::StatementKey& key, SQL_FACTORY createStatement, sqlite3_stmt **stmt)
+        {
+            return prepare(statements, key, createStatement, stmt);
+        }
+
+        /**
+         * Get a prepared statement for a custom query from the cache, keyed by its SQL text, or prepare and cache it if
+         * it does not exist. The statement is reset and its bindings are cleared before it is returned.
+         *
+         * @param query The SQL text of the statement.
+         * @param stmt The prepared statement output.
+         * @return The SQLite error code. Will be SQLITE_OK if the statement was found or successfully prepared.
+         */
+        int prepare(const std::string& query, sqlite3_stmt **stmt)
+        {
+            return prepare(queries, query, [&query]() { return query; }, stmt);
+        }
+
+        /// Number of statements currently in the cache.
+        size_t size() const { return statements.size() + queries.size(); }
+
+        /// Finalize all cached statements. The hit and miss counters are kept.
+        void clear()
+        {
+            for (auto& entry : statements)
+                sqlite3_finalize(entry.second);
+            statements.clear();
+            for (auto& entry : queries)
+                sqlite3_finalize(entry.second);
+            queries.clear();
+        }
+
+    private:
+        template<typename KEY, typename SQL_FACTORY>
+        int prepare(std::map<KEY, sqlite3_stmt*>& cached, const KEY& key, SQL_FACTORY createStatement, sqlite3_stmt **stmt)
+        {
+            auto it = cached.find(key);
+            if (it != cached.end())
+            {
+                hitCount++;
+                *stmt = it->second;
+                sqlite3_reset(*stmt);
+                sqlite3_clear_bindings(*stmt);
+                return SQLITE_OK;
+            }
+
+            missCount++;
+            const std::string query = createStatement();
+            int result = sqlite3_prepare_v2(database, query.c_str(), -1, stmt, NULL);
+            if (result != SQLITE_OK)
+                return result;
+
+            cached.insert(std::make_pair(key, *stmt));
+            return SQLITE_OK;
+        }
+
+        sqlite3 *database;
+        std::map<Internal::StatementKey, sqlite3_stmt*> statements;
+        std::map<std::string, sqlite3_stmt*> queries;
+        size_t hitCount;
+        size_t missCount;
+    };
+
+    /**
+     * Get the table name for an SQLT table struct.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @return The table name for the SQLT table struct template parameter.
+     */
+    template<typename SQLT_TABLE>
+    inline const std::string& tableName()
+    {
+        static const std::string name = SQLT_TABLE::template SQLTBase<SQLT_TABLE>::sqlt_static_table_name().toString();
+        return name;
+    }
+
+    /**
+     * Create a table if it does not already exist.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param db The sqlite3 instance to create the table in.
+     * @param errMsg The sqlite3 message output.
+     * @return The SQLite error code. Will be SQLITE_OK if the table was successfully created or if it already existed.
+     *
+     * @see SQLT::createAllTables(sqlite3 *db, char **errMsg)
+     * @see SQLT::createAllTables(char **errMsg)
+     */
+    template<typename SQLT_TABLE>
+    inline int createTableIfNotExists(sqlite3 *db, char **errMsg)
+    {
+        static const std::string query = []() -> std::string {
+            std::string query = std::string("CREATE TABLE IF NOT EXISTS ") + tableName<SQLT_TABLE>();
+            query += "(";
+            query += SQLT::Internal::createTableContents<SQLT_TABLE>();
+            size_t pkCount = SQLT::Internal::primaryKeyCount<SQLT_TABLE>();
+            if (pkCount > 0)
+            {
+                query += ",";
+                query += SQLT::Internal::createPrimaryKeyStatement<SQLT_TABLE>();
+            }
+            query += ")";
+            if (SQLT::Internal::withoutRowid<SQLT_TABLE>())
+                query += " WITHOUT ROWID";
+            query += ";";
+            return query;
+        }();
+        return sqlite3_exec(db, query.c_str(), NULL, NULL, errMsg);
+    }
+
+    /**
+     * Drop a table if it exists.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param db The sqlite3 instance to drop the table in.
+     * @param errMsg The sqlite3 message output.
+     * @return The SQLite error code. Will be SQLITE_OK if the table was successfully dropped or if it did not exist.
+     *
+     * @see SQLT::createAllTables(sqlite3 *db, char **errMsg)
+     * @see SQLT::createAllTables(char **errMsg)
+     */
+    template<typename SQLT_TABLE>
+    inline int dropTableIfExists(sqlite3 *db, char **errMsg)
+    {
+        static const std::string stmt = std::string("DROP TABLE IF EXISTS ") + tableName<SQLT_TABLE>() + ";";
+        return sqlite3_exec(db, stmt.c_str(), NULL, NULL, errMsg);
+    }
+
+    /**
+     * Insert a range of rows into a table. The rows are bound and inserted one at a time as the range is iterated, so
+     * the range can be produced lazily. The range may hold the rows themselves, pointers to rows or
+     * std::reference_wrapper's of rows, in which case the rows are not copied.
+     *
+     * @tparam ITERATOR An input iterator whose value type is an SQLT table struct, a pointer to one or a std::reference_wrapper of one.
+     * @param db The sqlite3 instance to insert into.
+     * @param first The first row to insert.
+     * @param last One past the last row to insert.
+     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully inserted.
+     *
+     * @see SQLT::insert(sqlite3 *db, const std::vector<SQLT_TABLE>& rows)
+     * @see SQLT::insertFrom(sqlite3 *db, GENERATOR next)
+     */
+    template<typename ITERATOR>
+    inline int insert(sqlite3 *db, ITERATOR first, ITERATOR last)
+    {
+        typedef typename SQLT::Internal::IteratorRowType<ITERATOR>::type SQLT_TABLE;
+        int result;
+        sqlite3_stmt *stmt;
+        const std::string& preparedStatement = SQLT::Internal::createInsertPreparedStatement<SQLT_TABLE>();
+
+        result = sqlite3_prepare_v2(db, preparedStatement.c_str(), -1, &stmt, NULL);
+        if (result != SQLITE_OK)
+            return result;
+
+        result = SQLT::Internal::insertRows(stmt, first, last);
+        if (result != SQLITE_OK)
+        {
+            sqlite3_finalize(stmt);
+            return result;
+        }
+
+        return sqlite3_finalize(stmt);
+    }
+
+    /**
+     * Insert a range of rows into a table using a cached prepared statement.
+     *
+     * @tparam ITERATOR An input iterator whose value type is an SQLT table struct, a pointer to one or a std::reference_wrapper of one.
+     * @param cache The statement cache of the sqlite3 instance to insert into.
+     * @param first The first row to insert.
+     * @param last One past the last row to insert.
+     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully inserted.
+     *
+     * @see SQLT::insert(sqlite3 *db, ITERATOR first, ITERATOR last)
+     */
+    template<typename ITERATOR>
+    inline int insert(StatementCache& cache, ITERATOR first, ITERATOR last)
+    {
+        typedef typename SQLT::Internal::IteratorRowType<ITERATOR>::type SQLT_TABLE;
+        int result;
+        sqlite3_stmt *stmt;
+        const SQLT::Internal::StatementKey key(SQLT::Internal::tableKey<SQLT_TABLE>(), SQLT::Internal::StatementKind::INSERT);
+
+        result = cache.prepare(key, &SQLT::Internal::createInsertPreparedStatement<SQLT_TABLE>, &stmt);
+        if (result != SQLITE_OK)
+            return result;
+
+        result = SQLT::Internal::insertRows(stmt, first, last);
+        sqlite3_reset(stmt);
+        return result;
+    }
+
+    /**
+     * Insert rows into a table.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param db The sqlite3 instance to drop the table in.
+     * @param rows The rows to insert into the database.
+     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully inserted.
+     *
+     * @see SQLT::insert(sqlite3 *db, const SQLT_TABLE& row)
+     * @see SQLT::insert(const std::vector<SQLT_TABLE>& rows)
+     * @see SQLT::insert(const SQLT_TABLE& row)
+     */
+    template<typename SQLT_TABLE>
+    inline int insert(sqlite3 *db, const std::vector<SQLT_TABLE>& rows)
+    {
+        return SQLT::insert(db, rows.begin(), rows.end());
+    }
+
+    /**
+     * Insert rows into a table using a cached prepared statement.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param cache The statement cache of the sqlite3 instance to insert into.
+     * @param rows The rows to insert into the database.
+     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully inserted.
+     *
+     * @see SQLT::insert(sqlite3 *db, const std::vector<SQLT_TABLE>& rows)
+     */
+    template<typename SQLT_TABLE>
+    inline int insert(StatementCache& cache, const std::vector<SQLT_TABLE>& rows)
+    {
+        return SQLT::insert(cache, rows.begin(), rows.end());
+    }
+
+    /**
+     * Insert rows into a table in the given order.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param db The sqlite3 instance to insert into.
+     * @param rows The rows to insert into the database.
+     * @param order The order to insert the rows in, see SQLT::InsertOrder.
+     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully inserted.
+     *
+     * @see SQLT::insert(sqlite3 *db, const std::vector<SQLT_TABLE>& rows)
+     */
+    template<typename SQLT_TABLE>
+    inline int insert(sqlite3 *db, const std::vector<SQLT_TABLE>& rows, InsertOrder order)
+    {
+        if (order == InsertOrder::PRIMARY_KEY)
+        {
+            const std::vector<const SQLT_TABLE*> sorted = SQLT::Internal::sortByPrimaryKey(rows);
+            return SQLT::insert(db, sorted.begin(), sorted.end());
+        }
+        return SQLT::insert(db, rows.begin(), rows.end());
+    }
+
+    /**
+     * Insert rows produced by a generator into a table. The generator is called with a reused row to fill in and returns
+     * false when there are no more rows. Each row is inserted before the generator is called again, so memory use stays
+     * constant regardless of the number of rows.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @tparam GENERATOR A callable with the signature bool(SQLT_TABLE& row).
+     * @param db The sqlite3 instance to insert into.
+     * @param next The generator. Fills in the next row and returns true, or returns false when done.
+     * @param insertedRows Optional output for the number of rows that were inserted, also when an error occurs.
+     * @return The SQLite error code. Will be SQLITE_OK if all generated rows were successfully inserted.
+     *
+     * @see SQLT::insert(sqlite3 *db, ITERATOR first, ITERATOR last)
+     */
+    template<typename SQLT_TABLE, typename GENERATOR>
+    inline int insertFrom(sqlite3 *db, GENERATOR next, size_t *insertedRows = nullptr)
+    {
+        int result;
+        sqlite3_stmt *stmt;
+        size_t inserted = 0;
+        const std::string& preparedStatement = SQLT::Internal::createInsertPreparedStatement<SQLT_TABLE>();
+
+        result = sqlite3_prepare_v2(db, preparedStatement.c_str(), -1, &stmt, NULL);
+        if (result != SQLITE_OK)
+            return result;
+
+        SQLT_TABLE row;
+        while (next(row))
+        {
+            result = SQLT::Internal::insertRow(stmt, row);
+            if (result != SQLITE_OK)
+                break;
+            inserted++;
+        }
+
+        if (insertedRows)
+            *insertedRows = inserted;
+
+        if (result != SQLITE_OK)
+        {
+            sqlite3_finalize(stmt);
+            return result;
+        }
+
+        return sqlite3_finalize(stmt);
+    }
+
+    /**
+     * Insert rows into a table using multi-row INSERT statements (i.e. "INSERT INTO table(...) VALUES(?,?),(?,?),...;").
+     *
+     * Each statement inserts as many rows as the SQLITE_LIMIT_VARIABLE_NUMBER limit of the connection allows, which
+     * reduces the number of sqlite3_step() calls by roughly that factor compared to SQLT::insert(). The remaining rows are
+     * inserted by a second statement sized to the remainder.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param db The sqlite3 instance to insert into.
+     * @param rows The rows to insert into the database.
+     * @param maxRowsPerStatement Optional upper limit on the number of rows per statement. 0 means no limit other than SQLITE_LIMIT_VARIABLE_NUMBER.
+     * @param order The order to insert the rows in, see SQLT::InsertOrder.
+     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully inserted.
+     *
+     * @see SQLT::insert(sqlite3 *db, const std::vector<SQLT_TABLE>& rows)
+     * @see SQLT::insertBatched(StatementCache& cache, const std::vector<SQLT_TABLE>& rows, size_t maxRowsPerStatement = 0)
+     */
+    template<typename SQLT_TABLE>
+    inline int insertBatched(sqlite3 *db, const std::vector<SQLT_TABLE>& rows, size_t maxRowsPerStatement = 0, InsertOrder order = InsertOrder::AS_GIVEN)
+    {
+        if (order == InsertOrder::PRIMARY_KEY)
+        {
+            const std::vector<const SQLT_TABLE*> sorted = SQLT::Internal::sortByPrimaryKey(rows);
+            return SQLT::Internal::insertBatched<SQLT_TABLE>(db, sorted.begin(), sorted.end(), maxRowsPerStatement);
+        }
+        return SQLT::Internal::insertBatched<SQLT_TABLE>(db, rows.begin(), rows.end(), maxRowsPerStatement);
+    }
+
+    /**
+     * Insert rows into a table using cached multi-row INSERT statements.
+     *
+     * The full-size statement is cached, keyed by its row count. The rows that do not fill a full statement are inserted
+     * one at a time with the cached single-row INSERT statement, so the number of cached statements does not grow with
+     * the number of distinct row counts.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param cache The statement cache of the sqlite3 instance to insert into.
+     * @param rows The rows to insert into the database.
+     * @param maxRowsPerStatement Optional upper limit on the number of rows per statement. 0 means no limit other than SQLITE_LIMIT_VARIABLE_NUMBER.
+     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully inserted.
+     *
+     * @see SQLT::insertBatched(sqlite3 *db, const std::vector<SQLT_TABLE>& rows, size_t maxRowsPerStatement = 0)
+     */
+    template<typename SQLT_TABLE>
+    inline int insertBatched(StatementCache& cache, const std::vector<SQLT_TABLE>& rows, size_t maxRowsPerStatement = 0)
+    {
+        int result;
+        sqlite3_stmt *stmt;
+        const int columnsPerRow = (int)SQLT::Internal::columnCount<SQLT_TABLE>();
+        const size_t batchRowCount = SQLT::Internal::batchedInsertRowCount<SQLT_TABLE>(cache.db(), maxRowsPerStatement);
+        const size_t tailRowCount = rows.size() % batchRowCount;
+        const auto tailBegin = rows.end() - tailRowCount;
+
+        if (rows.begin() != tailBegin)
+        {
+            const SQLT::Internal::StatementKey key(SQLT::Internal::tableKey<SQLT_TABLE>(), SQLT::Internal::StatementKind::INSERT_BATCH, batchRowCount);
+            result = cache.prepare(key, [batchRowCount]() { return SQLT::Internal::createBatchedInsertPreparedStatement<SQLT_TABLE>(batchRowCount); }, &stmt);
+            if (result != SQLITE_OK)
+                return result;
+
+            result = SQLT::Internal::insertRowsBatched(stmt, batchRowCount, columnsPerRow, rows.begin(), tailBegin);
+            sqlite3_reset(stmt);
+            if (result != SQLITE_OK)
+                return result;
+        }
+
+        // The remaining rows are inserted one at a time, so that a statement is only cached for the full batch size.
+        if (tailRowCount > 0)
+            return SQLT::insert(cache, tailBegin, rows.end());
+
+        return SQLITE_OK;
+    }
+
+    /**
+     * Insert rows into a table, resolving rows that conflict with existing rows on the primary key according to policy.
+     *
+     * With ConflictPolicy::UPDATE the statement is "INSERT ... ON CONFLICT(pk...) DO UPDATE SET col = excluded.col" for
+     * all non-primary key columns, which requires SQLite 3.24.0 or newer. Tables without primary key columns cannot be
+     * used with ConflictPolicy::UPDATE.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param db The sqlite3 instance to insert into.
+     * @param rows The rows to insert or update.
+     * @param policy How to handle rows whose primary key already exists.
+     * @return The SQLite error code. Will be SQLITE_OK if all rows were successfully inserted or updated, or SQLITE_MISUSE if policy is ConflictPolicy::UPDATE and the table has no primary key.
+     *
+     * @see SQLT::upsert(StatementCache& cache, const std::vector<SQLT_TABLE>& rows, ConflictPolicy policy = ConflictPolicy::UPDATE)
+     */
+    template<typename SQLT_TABLE>
+    inline int upsert(sqlite3 *db, const std::vector<SQLT_TABLE>& rows, ConflictPolicy policy = ConflictPolicy::UPDATE)
+    {
+        int result;
+        sqlite3_stmt *stmt;
+        if (policy == ConflictPolicy::UPDATE && SQLT::Internal::primaryKeyCount<SQLT_TABLE>() == 0)
+            return SQLITE_MISUSE;
+
+        const std::string preparedStatement = SQLT::Internal::createUpsertPreparedStatement<SQLT_TABLE>(policy);
+        result = sqlite3_prepare_v2(db, preparedStatement.c_str(), -1, &stmt, NULL);
+        if (result != SQLITE_OK)
+            return result;
+
+        result = SQLT::Internal::insertRows(stmt, rows.begin(), rows.end());
+        if (result != SQLITE_OK)
+        {
+            sqlite3_finalize(stmt);
+            return result;
+        }
+
+        return sqlite3_finalize(stmt);
+    }
+
+    /**
+     * Insert rows into a table using a cached prepared statement, resolving primary key conflicts according to policy.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param cache The statement cache of the sqlite3 instance to insert into.
+     * @param rows The rows to insert or update.
+     * @param policy How to handle rows whose primary key already exists.
+     * @return The SQLite error code. Will be SQLITE_OK if all rows were successfully inserted or updated, or SQLITE_MISUSE if policy is ConflictPolicy::UPDATE and the table has no primary key.
+     *
+     * @see SQLT::upsert(sqlite3 *db, const std::vector<SQLT_TABLE>& rows, ConflictPolicy policy = ConflictPolicy::UPDATE)
+     */
+    template<typename SQLT_TABLE>
+    inline int upsert(StatementCache& cache, const std::vector<SQLT_TABLE>& rows, ConflictPolicy policy = ConflictPolicy::UPDATE)
+    {
+        int result;
+        sqlite3_stmt *stmt;
+        if (policy == ConflictPolicy::UPDATE && SQLT::Internal::primaryKeyCount<SQLT_TABLE>() == 0)
+            return SQLITE_MISUSE;
+
+        const SQLT::Internal::StatementKey key(SQLT::Internal::tableKey<SQLT_TABLE>(), SQLT::Internal::StatementKind::UPSERT, (size_t)policy);
+        result = cache.prepare(key, [policy]() { return SQLT::Internal::createUpsertPreparedStatement<SQLT_TABLE>(policy); }, &stmt);
+        if (result != SQLITE_OK)
+            return result;
+
+        result = SQLT::Internal::insertRows(stmt, rows.begin(), rows.end());
+        sqlite3_reset(stmt);
+        return result;
+    }
+
+    /**
+     * Insert rows into a table with a single INSERT INTO ... SELECT statement that reads the rows from a virtual table.
+     *
+     * The rows are read by SQLite directly from the vector, instead of binding the values of each row and stepping a
+     * statement for each row as SQLT::insert() does. The virtual table module is registered on the connection the first
+     * time it is used. The statement either inserts all rows or, on an error, none of them.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param db The sqlite3 instance to insert into.
+     * @param rows The rows to insert into the database.
+     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully inserted.
+     *
+     * @see SQLT::insert(sqlite3 *db, const std::vector<SQLT_TABLE>& rows)
+     */
+    template<typename SQLT_TABLE>
+    inline int insertViaVirtualTable(sqlite3 *db, const std::vector<SQLT_TABLE>& rows)
+    {
+        int result;
+        sqlite3_stmt *stmt;
+
+        const std::string& preparedStatement = SQLT::Internal::createVirtualTableInsertPreparedStatement<SQLT_TABLE>();
+        result = sqlite3_prepare_v2(db, preparedStatement.c_str(), -1, &stmt, NULL);
+        if (result == SQLITE_ERROR && SQLT::Internal::VectorTable<SQLT_TABLE>::isModuleMissing(db) &&
+            SQLT::Internal::VectorTable<SQLT_TABLE>::registerModule(db) == SQLITE_OK)
+            result = sqlite3_prepare_v2(db, preparedStatement.c_str(), -1, &stmt, NULL);
+        if (result != SQLITE_OK)
+            return result;
+
+        result = sqlite3_bind_pointer(stmt, 1, const_cast<std::vector<SQLT_TABLE>*>(&rows), SQLT::Internal::VectorTable<SQLT_TABLE>::pointerType(), nullptr);
+        if (result == SQLITE_OK)
+        {
+            result = sqlite3_step(stmt);
+            if (result == SQLITE_DONE)
+                result = SQLITE_OK;
+        }
+
+        if (result != SQLITE_OK)
+        {
+            sqlite3_finalize(stmt);
+            return result;
+        }
+
+        return sqlite3_finalize(stmt);
+    }
+
+    /**
+     * Insert rows into a table and collect the rowid that each row was stored with, e.g. to link child rows to them.
+     *
+     * With assignPrimaryKey the primary key column is left out of the INSERT statement, so SQLite assigns a new key to
+     * each row and the primary key members of the rows are ignored. This requires a primary key of a single int column,
+     * which SQLite uses as the rowid.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param db The sqlite3 instance to insert into.
+     * @param rows The rows to insert into the database.
+     * @param ids The rowid of each inserted row is appended to ids, in the order of rows. Also the rowids of the rows
+     *            inserted before an error occurred.
+     * @param assignPrimaryKey Let SQLite assign the primary key instead of inserting the primary key members.
+     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully inserted. Will be SQLITE_MISUSE for
+     *         tables without rowid, or if assignPrimaryKey is set and the primary key is not a single int column.
+     *
+     * @see SQLT::insert(sqlite3 *db, const std::vector<SQLT_TABLE>& rows)
+     */
+    template<typename SQLT_TABLE>
+    inline int insertReturningIds(sqlite3 *db, const std::vector<SQLT_TABLE>& rows, std::vector<int64_t> *ids, bool assignPrimaryKey = false)
+    {
+        int result;
+        sqlite3_stmt *stmt;
+
+        if (SQLT::Internal::withoutRowid<SQLT_TABLE>() || (assignPrimaryKey && !SQLT::Internal::hasIntegerPrimaryKey<SQLT_TABLE>()))
+            return SQLITE_MISUSE;
+
+        const std::string& preparedStatement = assignPrimaryKey ? SQLT::Internal::createInsertGeneratedKeyPreparedStatement<SQLT_TABLE>()
+                                                               : SQLT::Internal::createInsertPreparedStatement<SQLT_TABLE>();
+        result = sqlite3_prepare_v2(db, preparedStatement.c_str(), -1, &stmt, NULL);
+        if (result != SQLITE_OK)
+            return result;
+
+        ids->reserve(ids->size() + rows.size());
+        for (const auto& row : rows)
+        {
+            sqlite3_reset(stmt);
+            if (assignPrimaryKey)
+                result = SQLT::Internal::iterateAndBindFilteredValues(row, stmt, SQLT::Internal::ColumnFilter::NON_PRIMARY_KEYS);
+            else
+                result = SQLT::Internal::iterateAndBindValues(row, stmt);
+            if (result != SQLITE_OK)
+                break;
+
+            result = sqlite3_step(stmt);
+            if (result != SQLITE_DONE)
+                break;
+            result = SQLITE_OK;
+
+            ids->push_back((int64_t)sqlite3_last_insert_rowid(db));
+        }
+
+        if (result != SQLITE_OK)
+        {
+            sqlite3_finalize(stmt);
+            return result;
+        }
+
+        return sqlite3_finalize(stmt);
+    }
+
+    /**
+     * Insert rows into a table, skipping the rows that can not be inserted instead of stopping at the first one.
+     *
+     * Rows that fail because of a constraint, a datatype mismatch or a too large value are recorded in failures and the
+     * remaining rows are still inserted. The rows are inserted in a savepoint, so this can also be used inside an open
+     * transaction. Any other error, e.g. SQLITE_BUSY or SQLITE_FULL, stops the insert and rolls back all of its rows.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param db The sqlite3 instance to insert into.
+     * @param rows The rows to insert into the database.
+     * @param failures The index and extended error code of each row that was not inserted is appended to failures, in
+     *                 the order of rows.
+     * @param insertedRows Optional output of the number of inserted rows. 0 if the insert failed.
+     * @return The SQLite error code. Will be SQLITE_OK if all rows except those in failures were inserted.
+     *
+     * @see SQLT::insert(sqlite3 *db, const std::vector<SQLT_TABLE>& rows)
+     */
+    template<typename SQLT_TABLE>
+    inline int insertSkippingFailures(sqlite3 *db, const std::vector<SQLT_TABLE>& rows, std::vector<InsertFailure> *failures, size_t *insertedRows = nullptr)
+    {
+        int result;
+        sqlite3_stmt *stmt;
+
+        const std::string& preparedStatement = SQLT::Internal::createInsertPreparedStatement<SQLT_TABLE>();
+        result = sqlite3_prepare_v2(db, preparedStatement.c_str(), -1, &stmt, NULL);
+        if (result != SQLITE_OK)
+            return result;
+
+        result = SQLT::Internal::insertRowsSkippingFailures(db, stmt, rows, failures, insertedRows);
+        sqlite3_finalize(stmt);
+        return result;
+    }
+
+    /**
+     * Insert rows into a table using a cached prepared statement, skipping the rows that can not be inserted.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param cache The statement cache of the sqlite3 instance to insert into.
+     * @param rows The rows to insert into the database.
+     * @param failures The index and extended error code of each row that was not inserted is appended to failures.
+     * @param insertedRows Optional output of the number of inserted rows. 0 if the insert failed.
+     * @return The SQLite error code. Will be SQLITE_OK if all rows except those in failures were inserted.
+     *
+     * @see SQLT::insertSkippingFailures(sqlite3 *db, const std::vector<SQLT_TABLE>& rows, std::vector<InsertFailure> *failures, size_t *insertedRows)
+     */
+    template<typename SQLT_TABLE>
+    inline int insertSkippingFailures(StatementCache& cache, const std::vector<SQLT_TABLE>& rows, std::vector<InsertFailure> *failures, size_t *insertedRows = nullptr)
+    {
+        int result;
+        sqlite3_stmt *stmt;
+        const SQLT::Internal::StatementKey key(SQLT::Internal::tableKey<SQLT_TABLE>(), SQLT::Internal::StatementKind::INSERT);
+
+        result = cache.prepare(key, &SQLT::Internal::createInsertPreparedStatement<SQLT_TABLE>, &stmt);
+        if (result != SQLITE_OK)
+            return result;
+
+        return SQLT::Internal::insertRowsSkippingFailures(cache.db(), stmt, rows, failures, insertedRows);
+    }
+
+    /**
+     * Insert a single row into a table.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param db The sqlite3 instance to drop the table in.
+     * @param row The row to insert into the database.
+     * @return The SQLite error code. Will be SQLITE_OK if the row was successfully inserted.
+     *
+     * @see SQLT::insert(sqlite3 *db, const std::vector<SQLT_TABLE>& rows)
+     * @see SQLT::insert(const std::vector<SQLT_TABLE>& rows)
+     * @see SQLT::insert(const SQLT_TABLE& row)
+     */
+    template<typename SQLT_TABLE>
+    inline int insert(sqlite3 *db, const SQLT_TABLE& row)
+    {
+        return SQLT::insert(db, &row, &row + 1);
+    }
+
+    /**
+     * Insert a single row into a table using a cached prepared statement. The row is bound directly, so once the
+     * statement is cached no heap allocations are made by this function.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param cache The statement cache of the sqlite3 instance to insert into.
+     * @param row The row to insert into the database.
+     * @return The SQLite error code. Will be SQLITE_OK if the row was successfully inserted.
+     *
+     * @see SQLT::insert(sqlite3 *db, const SQLT_TABLE& row)
+     */
+    template<typename SQLT_TABLE>
+    inline int insert(StatementCache& cache, const SQLT_TABLE& row)
+    {
+        int result;
+        sqlite3_stmt *stmt;
+        const SQLT::Internal::StatementKey key(SQLT::Internal::tableKey<SQLT_TABLE>(), SQLT::Internal::StatementKind::INSERT);
+
+        result = cache.prepare(key, &SQLT::Internal::createInsertPreparedStatement<SQLT_TABLE>, &stmt);
+        if (result != SQLITE_OK)
+            return result;
+
+        result = SQLT::Internal::insertRow(stmt, row);
+        sqlite3_reset(stmt);
+        return result;
+    }
+
+    /**
+     * Insert rows into a table.
+     *
+     * @tparam SQLT_DB The database to insert into, defined by SQLT_DATABASE, SQLT_DATABASE_WITH_NAME or SQLT_DATABASE_WITH_NAME_AND_PATH.
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param rows The rows to insert into the database.
+     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully inserted.
+     *
+     * @see SQLT::insert(sqlite3 *db, const std::vector<SQLT_TABLE>& rows)
+     * @see SQLT::insert(sqlite3 *db, const SQLT_TABLE& row)
+     * @see SQLT::insert(const SQLT_TABLE& row)
+     */
+    template<typename SQLT_DB, typename SQLT_TABLE>
+    inline int insert(const std::vector<SQLT_TABLE>& rows)
+    {
+        int result;
+        sqlite3 *db;
+        auto dbInfo = SQLT_DB::template SQLTDatabase<SQLT_DB>::sqlt_static_database_info();
+
+        result = sqlite3_open(dbInfo.dbFilePath().c_str(), &db);
+        if (result != SQLITE_OK)
+        {
+            sqlite3_close(db);
+            return result;
+        }
+
+        result = SQLT::insert<SQLT_TABLE>(db, rows);
+
+        if (result != SQLITE_OK)
+        {
+            sqlite3_close(db);
+            return result;
+        }
+
+        return sqlite3_close(db);
+    }
+
+    /**
+     * Insert a single row into a table.
+     *
+     * @tparam SQLT_DB The database to insert into, defined by SQLT_DATABASE, SQLT_DATABASE_WITH_NAME or SQLT_DATABASE_WITH_NAME_AND_PATH.
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param row The row to insert into the database.
+     * @return The SQLite error code. Will be SQLITE_OK if the row was successfully inserted.
+     *
+     * @see SQLT::insert(sqlite3 *db, const std::vector<SQLT_TABLE>& rows)
+     * @see SQLT::insert(sqlite3 *db, const SQLT_TABLE& row)
+     * @see SQLT::insert(const std::vector<SQLT_TABLE>& rows)
+     */
+    template<typename SQLT_DB, typename SQLT_TABLE>
+    inline int insert(const SQLT_TABLE& row)
+    {
+        int result;
+        sqlite3 *db;
+        auto dbInfo = SQLT_DB::template SQLTDatabase<SQLT_DB>::sqlt_static_database_info();
+
+        result = sqlite3_open(dbInfo.dbFilePath().c_str(), &db);
+        if (result != SQLITE_OK)
+        {
+            sqlite3_close(db);
+            return result;
+        }
+
+        result = SQLT::insert<SQLT_TABLE>(db, row);
+
+        if (result != SQLITE_OK)
+        {
+            sqlite3_close(db);
+            return result;
+        }
+
+        return sqlite3_close(db);
+    }
+
+    /**
+     * Progress callback for SQLT::bulkInsert(). Called after each committed chunk with the number of rows committed so
+     * far and the total number of rows to insert.
+     */
+    typedef std::function<void(size_t committedRows, size_t totalRows)> BulkInsertProgress;
+
+    /**
+     * Insert rows into a table in chunks, each chunk wrapped in its own "BEGIN IMMEDIATE" / "COMMIT" transaction.
+     *
+     * Must not be called while a transaction is already open on the connection. If a chunk fails, that chunk is rolled
+     * back, the chunks before it stay committed and committedRows tells how many rows made it into the database.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param db The sqlite3 instance to insert into.
+     * @param rows The rows to insert into the database.
+     * @param chunkRows The number of rows per transaction. 0 inserts all rows in a single transaction.
+     * @param committedRows Optional output for the number of rows that were committed, also when an error occurs.
+     * @param progress Optional callback that is called after each committed chunk.
+     * @return The SQLite error code. Will be SQLITE_OK if all rows were successfully inserted and committed.
+     *
+     * @see SQLT::bulkInsert(const std::vector<SQLT_TABLE>& rows, size_t chunkRows = 10000, size_t *committedRows = nullptr, const BulkInsertProgress& progress = nullptr)
+     */
+    template<typename SQLT_TABLE>
+    inline int bulkInsert(sqlite3 *db, const std::vector<SQLT_TABLE>& rows, size_t chunkRows = 10000, size_t *committedRows = nullptr, const BulkInsertProgress& progress = nullptr)
+    {
+        int result;
+        sqlite3_stmt *stmt;
+        size_t committed = 0;
+        if (committedRows)
+            *committedRows = 0;
+
+        if (chunkRows == 0)
+            chunkRows = rows.size();
+
+        const std::string& preparedStatement = SQLT::Internal::createInsertPreparedStatement<SQLT_TABLE>();
+        result = sqlite3_prepare_v2(db, preparedStatement.c_str(), -1, &stmt, NULL);
+        if (result != SQLITE_OK)
+            return result;
+
+        while (committed < rows.size())
+        {
+            const size_t chunkSize = std::min(chunkRows, rows.size() - committed);
+            const auto chunkBegin = rows.begin() + committed;
+
+            result = sqlite3_exec(db, "BEGIN IMMEDIATE", NULL, NULL, NULL);
+            if (result != SQLITE_OK)
+                break;
+
+            result = SQLT::Internal::insertRows(stmt, chunkBegin, chunkBegin + chunkSize);
+            sqlite3_reset(stmt);
+            if (result == SQLITE_OK)
+                result = sqlite3_exec(db, "COMMIT", NULL, NULL, NULL);
+
+            if (result != SQLITE_OK)
+            {
+                if (!sqlite3_get_autocommit(db))
+                    sqlite3_exec(db, "ROLLBACK", NULL, NULL, NULL);
+                break;
+            }
+
+            committed += chunkSize;
+            if (committedRows)
+                *committedRows = committed;
+            if (progress)
+                progress(committed, rows.size());
+        }
+
+        if (result != SQLITE_OK)
+        {
+            sqlite3_finalize(stmt);
+            return result;
+        }
+
+        return sqlite3_finalize(stmt);
+    }
+
+    /**
+     * Insert rows into a table in chunks, each chunk wrapped in its own "BEGIN IMMEDIATE" / "COMMIT" transaction.
+     *
+     * @tparam SQLT_DB The database to insert into, defined by SQLT_DATABASE, SQLT_DATABASE_WITH_NAME or SQLT_DATABASE_WITH_NAME_AND_PATH.
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param rows The rows to insert into the database.
+     * @param chunkRows The number of rows per transaction. 0 inserts all rows in a single transaction.
+     * @param committedRows Optional output for the number of rows that were committed, also when an error occurs.
+     * @param progress Optional callback that is called after each committed chunk.
+     * @return The SQLite error code. Will be SQLITE_OK if all rows were successfully inserted and committed.
+     *
+     * @see SQLT::bulkInsert(sqlite3 *db, const std::vector<SQLT_TABLE>& rows, size_t chunkRows = 10000, size_t *committedRows = nullptr, const BulkInsertProgress& progress = nullptr)
+     */
+    template<typename SQLT_DB, typename SQLT_TABLE>
+    inline int bulkInsert(const std::vector<SQLT_TABLE>& rows, size_t chunkRows = 10000, size_t *committedRows = nullptr, const BulkInsertProgress& progress = nullptr)
+    {
+        int result;
+        sqlite3 *db;
+        auto dbInfo = SQLT_DB::template SQLTDatabase<SQLT_DB>::sqlt_static_database_info();
+
+        result = sqlite3_open(dbInfo.dbFilePath().c_str(), &db);
+        if (result != SQLITE_OK)
+        {
+            sqlite3_close(db);
+            return result;
+        }
+
+        result = SQLT::bulkInsert<SQLT_TABLE>(db, rows, chunkRows, committedRows, progress);
+
+        if (result != SQLITE_OK)
+        {
+            sqlite3_close(db);
+            return result;
+        }
+
+        return sqlite3_close(db);
+    }
+
+    /**
+     * Select rows from a custom SQLite query into the corresponding query struct.
+     *
+     * @tparam SQLT_QUERY_STRUCT An SQLT query struct defined by SQLT_QUERY_RESULT_STRUCT.
+     * @param db The sqlite3 instance to select the rows from.
+     * @param selectQuery The SQLite SELECT query to perform to select rows into the output vector.
+     * @param output The vector to save the results in. Will be resized to approximate_row_count in the process. Is expected to be empty, but the vector will not be cleared.
+     * @param approximate_row_count Optional number for initial vector.reserve() call. Should be equal to the expected row count if possible (if such information is available), to avoid unneccesary allocations.
+     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully selected.
+     *
+     * @see SQLT::select(const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
+     * @see SQLT::selectAll(sqlite3 *db, std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
+     * @see SQLT::selectAll(std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
+     * @see SQLT::select(sqlite3 *db, T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
+     * @see SQLT::select(T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
+     */
+    template<typename SQLT_QUERY_STRUCT>
+    inline int select(sqlite3 *db, const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
+    {
+        int result = SQLITE_ERROR;
+
+        sqlite3_stmt *stmt;
+        result = sqlite3_prepare_v2(db, selectQuery.c_str(), -1, &stmt, NULL);
+        if (result != SQLITE_OK)
+            return result;
+
+        result = Internal::selectQueryRows(stmt, output, approximate_row_count);
+        if (result != SQLITE_OK)
+        {
+            sqlite3_finalize(stmt);
+            return result;
+        }
+
+        result = sqlite3_finalize(stmt);
+        return result;
+    }
+
+    /**
+     * Create the parameters of a custom query for SQLT::select(). The arguments are bound to ?1, ?2, ... in order and
+     * can be of any type that a column can have, as well as const char* and int64_t.
+     *
+     * @param args The values of the parameters. They are referenced, not copied, until the query has been executed.
+     * @return The parameters.
+     */
+    template<typename... ARGS>
+    inline Internal::Parameters<ARGS...> params(const ARGS&... args)
+    {
+        return Internal::Parameters<ARGS...>(args...);
+    }
+
+    /**
+     * Select rows from a custom SQLite query with bound parameters into the corresponding query struct.
+     *
+     * @tparam SQLT_QUERY_STRUCT An SQLT query struct defined by SQLT_QUERY_RESULT_STRUCT.
+     * @param db The sqlite3 instance to select the rows from.
+     * @param selectQuery The SQLite SELECT query to perform, with ? parameters.
+     * @param output The vector to save the results in. Is expected to be empty, but the vector will not be cleared.
+     * @param parameters The parameter values, created by SQLT::params(args...).
+     * @param approximate_row_count Optional number for initial vector.reserve() call.
+     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully selected.
+     *
+     * @see SQLT::select(sqlite3 *db, const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
+     * @see SQLT::select(StatementCache& cache, const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, const Internal::Parameters<ARGS...>& parameters, size_t approximate_row_count = 50)
+     */
+    template<typename SQLT_QUERY_STRUCT, typename... ARGS>
+    inline int select(sqlite3 *db, const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, const Internal::Parameters<ARGS...>& parameters, size_t approximate_row_count = 50)
+    {
+        int result;
+        sqlite3_stmt *stmt;
+
+        result = sqlite3_prepare_v2(db, selectQuery.c_str(), -1, &stmt, NULL);
+        if (result != SQLITE_OK)
+            return result;
+
+        result = Internal::bindParameters(stmt, parameters);
+        if (result == SQLITE_OK)
+            result = Internal::selectQueryRows(stmt, output, approximate_row_count);
+        if (result != SQLITE_OK)
+        {
+            sqlite3_finalize(stmt);
+            return result;
+        }
+
+        return sqlite3_finalize(stmt);
+    }
+
+    /**
+     * Select rows from a custom SQLite query with bound parameters using a statement cached by the SQL text.
+     *
+     * @tparam SQLT_QUERY_STRUCT An SQLT query struct defined by SQLT_QUERY_RESULT_STRUCT.
+     * @param cache The statement cache of the sqlite3 instance to select the rows from.
+     * @param selectQuery The SQLite SELECT query to perform, with ? parameters.
+     * @param output The vector to save the results in. Is expected to be empty, but the vector will not be cleared.
+     * @param parameters The parameter values, created by SQLT::params(args...).
+     * @param approximate_row_count Optional number for initial vector.reserve() call.
+     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully selected.
+     *
+     * @see SQLT::select(sqlite3 *db, const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, const Internal::Parameters<ARGS...>& parameters, size_t approximate_row_count = 50)
+     */
+    template<typename SQLT_QUERY_STRUCT, typename... ARGS>
+    inline int select(StatementCache& cache, const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, const Internal::Parameters<ARGS...>& parameters, size_t approximate_row_count = 50)
+    {
+        int result;
+        sqlite3_stmt *stmt;
+
+        result = cache.prepare(selectQuery, &stmt);
+        if (result != SQLITE_OK)
+            return result;
+
+        result = Internal::bindParameters(stmt, parameters);
+        if (result == SQLITE_OK)
+            result = Internal::selectQueryRows(stmt, output, approximate_row_count);
+        sqlite3_reset(stmt);
+        return result;
+    }
+
+    /**
+     * Select rows from a custom SQLite query into the corresponding query struct.
+     *
+     * @tparam SQLT_QUERY_STRUCT An SQLT query struct defined by SQLT_QUERY_RESULT_STRUCT.
+     * @tparam SQLT_DB The database to select from, defined by SQLT_DATABASE, SQLT_DATABASE_WITH_NAME or SQLT_DATABASE_WITH_NAME_AND_PATH.
+     * @param selectQuery The SQLite SELECT query to perform to select rows into the output vector.
+     * @param output The vector to save the results in. Will be resized to approximate_row_count in the process. Is expected to be empty, but the vector will not be cleared.
+     * @param approximate_row_count Optional number for initial vector.reserve() call. Should be equal to the expected row count if possible (if such information is available), to avoid unneccesary allocations.
+     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully selected.
+     *
+     * @see SQLT::select(sqlite3 *db, const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
+     * @see SQLT::selectAll(sqlite3 *db, std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
+     * @see SQLT::selectAll(std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
+     * @see SQLT::select(sqlite3 *db, T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
+     * @see SQLT::select(T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
+     */
+    template<typename SQLT_DB, typename SQLT_QUERY_STRUCT>
+    inline int select(const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
+    {
+        int result;
+        sqlite3 *db;
+        auto dbInfo = SQLT_DB::template SQLTDatabase<SQLT_DB>::sqlt_static_database_info();
+
+        result = sqlite3_open(dbInfo.dbFilePath().c_str(), &db);
+        if (result != SQLITE_OK)
+        {
+            sqlite3_close(db);
+            return result;
+        }
+
+        result = SQLT::select<SQLT_QUERY_STRUCT>(db, selectQuery, output, approximate_row_count);
+
+        if (result != SQLITE_OK)
+        {
+            sqlite3_close(db);
+            return result;
+        }
+
+        result = sqlite3_close(db);
+        return result;
+    }
+
+    /**
+     * Select all rows from a table.
+     *
      * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
-     * @param row The row to insert into the database.
-     * @return The SQLite error code. Will be SQLITE_OK if the row was successfully inserted.
+     * @param db The sqlite3 instance to select the rows from.
+     * @param output The vector to save the results in. Will be resized to approximate_row_count in the process. Is expected to be empty, but the vector will not be cleared.
+     * @param approximate_row_count Optional number for initial vector.reserve() call. Should be equal to or greater than the expected row count, if such information is available, to avoid unneccesary allocations.
+     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully selected.
      *
-     * @see SQLT::insert(sqlite3 *db, const std::vector<SQLT_TABLE>& rows)
-     * @see SQLT::insert(sqlite3 *db, const SQLT_TABLE& row)
-     * @see SQLT::insert(const std::vector<SQLT_TABLE>& rows)
+     * @see SQLT::select(sqlite3 *db, const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
+     * @see SQLT::select(const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
+     * @see SQLT::selectAll(std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
+     * @see SQLT::select(sqlite3 *db, T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
+     * @see SQLT::select(T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
+     */
+    template<typename SQLT_TABLE>
+    inline int selectAll(sqlite3 *db, std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
+    {
+        int result;
+        sqlite3_stmt *stmt;
+        const std::string& query = SQLT::Internal::createSelectAllPreparedStatement<SQLT_TABLE>();
+        result = sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, NULL);
+        if (result != SQLITE_OK)
+            return result;
+
+        result = SQLT::Internal::selectAllRows(stmt, output, approximate_row_count);
+        if (result != SQLITE_OK)
+        {
+            sqlite3_finalize(stmt);
+            return result;
+        }
+
+        result = sqlite3_finalize(stmt);
+        return result;
+    }
+
+    /**
+     * Select all rows from a table using a cached prepared statement.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param cache The statement cache of the sqlite3 instance to select the rows from.
+     * @param output The vector to save the results in. Is expected to be empty, but the vector will not be cleared.
+     * @param approximate_row_count Optional number for initial vector.reserve() call. Should be equal to or greater than the expected row count, if such information is available, to avoid unneccesary allocations.
+     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully selected.
+     *
+     * @see SQLT::selectAll(sqlite3 *db, std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
+     */
+    template<typename SQLT_TABLE>
+    inline int selectAll(StatementCache& cache, std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
+    {
+        int result;
+        sqlite3_stmt *stmt;
+        const SQLT::Internal::StatementKey key(SQLT::Internal::tableKey<SQLT_TABLE>(), SQLT::Internal::StatementKind::SELECT_ALL);
+
+        result = cache.prepare(key, &SQLT::Internal::createSelectAllPreparedStatement<SQLT_TABLE>, &stmt);
+        if (result != SQLITE_OK)
+            return result;
+
+        result = SQLT::Internal::selectAllRows(stmt, output, approximate_row_count);
+        sqlite3_reset(stmt);
+        return result;
+    }
+
+    /**
+     * Select all rows from a table into a vector holding the rows of a previous select, e.g. when polling a table. The
+     * existing rows are overwritten in place and keep their string buffers, and rows are only appended or erased at the
+     * end of the vector, so selecting rows that did not change makes no allocations.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param db The sqlite3 instance to select the rows from.
+     * @param output The vector to overwrite with the selected rows. Holds a partial result if an error occurs.
+     * @param changedRows Optional output of the number of rows that differ from the previous contents of output at the
+     *        same position, including the rows that were appended or erased.
+     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully selected.
+     *
+     * @see SQLT::selectAll(sqlite3 *db, std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
+     */
+    template<typename SQLT_TABLE>
+    inline int selectInto(sqlite3 *db, std::vector<SQLT_TABLE> *output, size_t *changedRows = nullptr)
+    {
+        int result;
+        sqlite3_stmt *stmt;
+        const std::string& query = SQLT::Internal::createSelectAllPreparedStatement<SQLT_TABLE>();
+        result = sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, NULL);
+        if (result != SQLITE_OK)
+            return result;
+
+        result = SQLT::Internal::selectAllRowsInto(stmt, output, changedRows);
+        if (result != SQLITE_OK)
+        {
+            sqlite3_finalize(stmt);
+            return result;
+        }
+
+        return sqlite3_finalize(stmt);
+    }
+
+    /**
+     * Select all rows from a table into a vector holding the rows of a previous select, using a cached prepared statement.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param cache The statement cache of the sqlite3 instance to select the rows from.
+     * @param output The vector to overwrite with the selected rows. Holds a partial result if an error occurs.
+     * @param changedRows Optional output of the number of rows that differ from the previous contents of output at the
+     *        same position, including the rows that were appended or erased.
+     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully selected.
+     *
+     * @see SQLT::selectInto(sqlite3 *db, std::vector<SQLT_TABLE> *output, size_t *changedRows = nullptr)
+     */
+    template<typename SQLT_TABLE>
+    inline int selectInto(StatementCache& cache, std::vector<SQLT_TABLE> *output, size_t *changedRows = nullptr)
+    {
+        int result;
+        sqlite3_stmt *stmt;
+        const SQLT::Internal::StatementKey key(SQLT::Internal::tableKey<SQLT_TABLE>(), SQLT::Internal::StatementKind::SELECT_ALL);
+
+        result = cache.prepare(key, &SQLT::Internal::createSelectAllPreparedStatement<SQLT_TABLE>, &stmt);
+        if (result != SQLITE_OK)
+            return result;
+
+        result = SQLT::Internal::selectAllRowsInto(stmt, output, changedRows);
+        sqlite3_reset(stmt);
+        return result;
+    }
+
+    /**
+     * Select all rows from a table.
+     *
+     * @tparam SQLT_DB The database to insert into, defined by SQLT_DATABASE, SQLT_DATABASE_WITH_NAME or SQLT_DATABASE_WITH_NAME_AND_PATH.
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param output The vector to save the results in. Will be resized to approximate_row_count in the process. Is expected to be empty, but the vector will not be cleared.
+     * @param approximate_row_count Optional number for initial vector.reserve() call. Should be equal to or greater than the expected row count, if such information is available, to avoid unneccesary allocations.
+     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully selected.
+     *
+     * @see SQLT::select(sqlite3 *db, const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
+     * @see SQLT::select(const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
+     * @see SQLT::selectAll(sqlite3 *db, std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
+     * @see SQLT::select(sqlite3 *db, T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
+     * @see SQLT::select(T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
+     */
+    template<typename SQLT_DB, typename SQLT_TABLE>
+    inline int selectAll(std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
+    {
+        int result;
+        sqlite3 *db;
+        auto dbInfo = SQLT_DB::template SQLTDatabase<SQLT_DB>::sqlt_static_database_info();
+
+        result = sqlite3_open(dbInfo.dbFilePath().c_str(), &db);
+        if (result != SQLITE_OK)
+        {
+            sqlite3_close(db);
+            return result;
+        }
+
+        result = SQLT::selectAll<SQLT_TABLE>(db, output, approximate_row_count);
+        if (result != SQLITE_OK)
+        {
+            sqlite3_close(db);
+            return result;
+        }
+
+        return sqlite3_close(db);
+    }
+
+    /**
+     * Stream the rows of a custom SQLite query to a callback instead of collecting them in a vector. Every row is
+     * decoded into the same query struct, so memory use does not grow with the number of rows.
+     *
+     * @tparam SQLT_QUERY_STRUCT An SQLT query struct defined by SQLT_QUERY_RESULT_STRUCT.
+     * @tparam ROW_CALLBACK A callable taking a const SQLT_QUERY_STRUCT& and returning bool.
+     * @param db The sqlite3 instance to select the rows from.
+     * @param selectQuery The SQLite SELECT query to perform.
+     * @param callback Called once per row. Return false to stop before the remaining rows.
+     * @return The SQLite error code. Will be SQLITE_OK if all rows were passed to callback or callback stopped early.
+     *
+     * @see SQLT::select(sqlite3 *db, const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
+     * @see SQLT::forEachAll(sqlite3 *db, ROW_CALLBACK callback)
+     */
+    template<typename SQLT_QUERY_STRUCT, typename ROW_CALLBACK>
+    inline int forEach(sqlite3 *db, const std::string& selectQuery, ROW_CALLBACK callback)
+    {
+        int result;
+        sqlite3_stmt *stmt;
+
+        result = sqlite3_prepare_v2(db, selectQuery.c_str(), -1, &stmt, NULL);
+        if (result != SQLITE_OK)
+            return result;
+
+        result = Internal::forEachQueryRow<SQLT_QUERY_STRUCT>(stmt, callback);
+        if (result != SQLITE_OK)
+        {
+            sqlite3_finalize(stmt);
+            return result;
+        }
+
+        return sqlite3_finalize(stmt);
+    }
+
+    /**
+     * Stream the rows of a custom SQLite query with bound parameters to a callback.
+     *
+     * @tparam SQLT_QUERY_STRUCT An SQLT query struct defined by SQLT_QUERY_RESULT_STRUCT.
+     * @tparam ROW_CALLBACK A callable taking a const SQLT_QUERY_STRUCT& and returning bool.
+     * @param db The sqlite3 instance to select the rows from.
+     * @param selectQuery The SQLite SELECT query to perform, with ? parameters.
+     * @param parameters The parameter values, created by SQLT::params(args...).
+     * @param callback Called once per row. Return false to stop before the remaining rows.
+     * @return The SQLite error code. Will be SQLITE_OK if all rows were passed to callback or callback stopped early.
+     *
+     * @see SQLT::forEach(sqlite3 *db, const std::string& selectQuery, ROW_CALLBACK callback)
+     */
+    template<typename SQLT_QUERY_STRUCT, typename ROW_CALLBACK, typename... ARGS>
+    inline int forEach(sqlite3 *db, const std::string& selectQuery, const Internal::Parameters<ARGS...>& parameters, ROW_CALLBACK callback)
+    {
+        int result;
+        sqlite3_stmt *stmt;
+
+        result = sqlite3_prepare_v2(db, selectQuery.c_str(), -1, &stmt, NULL);
+        if (result != SQLITE_OK)
+            return result;
+
+        result = Internal::bindParameters(stmt, parameters);
+        if (result == SQLITE_OK)
+            result = Internal::forEachQueryRow<SQLT_QUERY_STRUCT>(stmt, callback);
+        if (result != SQLITE_OK)
+        {
+            sqlite3_finalize(stmt);
+            return result;
+        }
+
+        return sqlite3_finalize(stmt);
+    }
+
+    /**
+     * Stream all rows of a table to a callback instead of collecting them in a vector. Every row is decoded into the
+     * same table struct, so memory use does not grow with the number of rows.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @tparam ROW_CALLBACK A callable taking a const SQLT_TABLE& and returning bool.
+     * @param db The sqlite3 instance to select the rows from.
+     * @param callback Called once per row. Return false to stop before the remaining rows.
+     * @return The SQLite error code. Will be SQLITE_OK if all rows were passed to callback or callback stopped early.
+     *
+     * @see SQLT::selectAll(sqlite3 *db, std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
+     * @see SQLT::forEach(sqlite3 *db, const std::string& selectQuery, ROW_CALLBACK callback)
      */
-    template<typename SQLT_DB, typename SQLT_TABLE>
-    inline int insert(const SQLT_TABLE& row)
+    template<typename SQLT_TABLE, typename ROW_CALLBACK>
+    inline int forEachAll(sqlite3 *db, ROW_CALLBACK callback)
     {
-        return SQLT::insert<SQLT_DB, SQLT_TABLE>(std::vector<SQLT_TABLE>({row}));
+        int result;
+        sqlite3_stmt *stmt;
+        const std::string& query = SQLT::Internal::createSelectAllPreparedStatement<SQLT_TABLE>();
+        result = sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, NULL);
+        if (result != SQLITE_OK)
+            return result;
+
+        result = SQLT::Internal::forEachTableRow<SQLT_TABLE>(stmt, callback);
+        if (result != SQLITE_OK)
+        {
+            sqlite3_finalize(stmt);
+            return result;
+        }
+
+        return sqlite3_finalize(stmt);
     }
 
     /**
-     * Select rows from a custom SQLite query into the corresponding query struct.
+     * A prepared SELECT statement whose rows are decoded one at a time while it is iterated, for both SQLT tables and
+     * SQLT query structs. The columns are assigned to the members by their names, so a table can be read by a custom
+     * query as well. Every row is decoded into the same struct, which an iterator refers to until it is incremented.
      *
-     * @tparam SQLT_QUERY_STRUCT An SQLT query struct defined by SQLT_QUERY_RESULT_STRUCT.
+     * The statement is finalized when the cursor is destroyed, or reset if it is owned by a StatementCache. A cached
+     * statement must not be used by other calls while the cursor exists. Text parameters are bound without being copied
+     * and must outlive the cursor.
+     *
+     * @tparam SQLT_STRUCT An SQLT table struct or an SQLT query struct defined by SQLT_QUERY_RESULT_STRUCT.
+     *
+     * @see SQLT::forEach(sqlite3 *db, const std::string& selectQuery, ROW_CALLBACK callback)
+     */
+    template<typename SQLT_STRUCT>
+    class Cursor
+    {
+    public:
+        class Iterator
+        {
+        public:
+            typedef std::input_iterator_tag iterator_category;
+            typedef SQLT_STRUCT value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const SQLT_STRUCT* pointer;
+            typedef const SQLT_STRUCT& reference;
+
+            Iterator() : cursor(nullptr) {}
+            explicit Iterator(Cursor *cursor) : cursor(cursor) {}
+
+            reference operator*() const { return cursor->row; }
+            pointer operator->() const { return &cursor->row; }
+
+            Iterator& operator++()
+            {
+                if (!cursor->step())
+                    cursor = nullptr;
+                return *this;
+            }
+
+            bool operator==(const Iterator& other) const { return cursor == other.cursor; }
+            bool operator!=(const Iterator& other) const { return cursor != other.cursor; }
+
+        private:
+            Cursor *cursor;
+        };
+
+        /// Select all rows of the table SQLT_STRUCT.
+        explicit Cursor(sqlite3 *db)
+            : Cursor()
+        {
+            const std::string& query = Internal::createSelectAllPreparedStatement<SQLT_STRUCT>();
+            open(sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, NULL));
+        }
+
+        /// Select all rows of the table SQLT_STRUCT using a cached prepared statement.
+        explicit Cursor(StatementCache& cache)
+            : Cursor()
+        {
+            const Internal::StatementKey key(Internal::tableKey<SQLT_STRUCT>(), Internal::StatementKind::SELECT_ALL);
+            owned = false;
+            open(cache.prepare(key, &Internal::createSelectAllPreparedStatement<SQLT_STRUCT>, &stmt));
+        }
+
+        /// Select the rows of a custom SQLite query.
+        Cursor(sqlite3 *db, const std::string& selectQuery)
+            : Cursor()
+        {
+            open(sqlite3_prepare_v2(db, selectQuery.c_str(), -1, &stmt, NULL));
+        }
+
+        /// Select the rows of a custom SQLite query with bound parameters, created by SQLT::params(args...).
+        template<typename... ARGS>
+        Cursor(sqlite3 *db, const std::string& selectQuery, const Internal::Parameters<ARGS...>& parameters)
+            : Cursor(db, selectQuery)
+        {
+            if (resultCode == SQLITE_OK)
+                resultCode = Internal::bindParameters(stmt, parameters);
+        }
+
+        /// Select the rows of a custom SQLite query with bound parameters using a statement cached by the SQL text.
+        template<typename... ARGS>
+        Cursor(StatementCache& cache, const std::string& selectQuery, const Internal::Parameters<ARGS...>& parameters)
+            : Cursor()
+        {
+            owned = false;
+            open(cache.prepare(selectQuery, &stmt));
+            if (resultCode == SQLITE_OK)
+                resultCode = Internal::bindParameters(stmt, parameters);
+        }
+
+        Cursor(Cursor&& other)
+            : stmt(other.stmt)
+            , owned(other.owned)
+            , resultCode(other.resultCode)
+            , state(other.state)
+            , assigners(std::move(other.assigners))
+            , row(std::move(other.row))
+        {
+            other.stmt = nullptr;
+        }
+
+        ~Cursor()
+        {
+            if (!stmt)
+                return;
+            if (owned)
+                sqlite3_finalize(stmt);
+            else
+                sqlite3_reset(stmt);
+        }
+
+        Cursor(const Cursor&) = delete;
+        Cursor& operator=(const Cursor&) = delete;
+        Cursor& operator=(Cursor&&) = delete;
+
+        /**
+         * Step to the first row, unless the cursor has already been stepped.
+         *
+         * @return An iterator to the current row, or end() if there are no more rows.
+         */
+        Iterator begin()
+        {
+            if (state == State::NOT_STARTED)
+                step();
+            return state == State::ROW ? Iterator(this) : Iterator();
+        }
+
+        Iterator end()
+        {
+            return Iterator();
+        }
+
+        /// Rewind the cursor so that the rows can be iterated again. The bound parameters are kept.
+        void reset()
+        {
+            if (!stmt || (resultCode != SQLITE_OK && state == State::NOT_STARTED))
+                return;
+            sqlite3_reset(stmt);
+            resultCode = SQLITE_OK;
+            state = State::NOT_STARTED;
+        }
+
+        /**
+         * @return The SQLite error code. Will be SQLITE_OK unless preparing, binding or stepping the statement failed, in
+         * which case the iteration ends early.
+         */
+        int result() const { return resultCode; }
+
+    private:
+        enum class State : uint8_t
+        {
+            NOT_STARTED,
+            ROW,
+            DONE
+        };
+
+        Cursor()
+            : stmt(nullptr)
+            , owned(true)
+            , resultCode(SQLITE_OK)
+            , state(State::NOT_STARTED)
+        {}
+
+        void open(int prepareResult)
+        {
+            resultCode = prepareResult;
+            if (resultCode == SQLITE_OK)
+                assigners = Internal::resolveColumnAssigners<SQLT_STRUCT>(stmt);
+            else if (owned)
+                sqlite3_finalize(stmt);
+            if (resultCode != SQLITE_OK)
+                stmt = nullptr;
+        }
+
+        bool step()
+        {
+            if (!stmt || resultCode != SQLITE_OK || state == State::DONE)
+            {
+                state = State::DONE;
+                return false;
+            }
+
+            int result = sqlite3_step(stmt);
+            if (result != SQLITE_ROW)
+            {
+                if (result != SQLITE_DONE)
+                    resultCode = result;
+                state = State::DONE;
+                return false;
+            }
+
+            const int count = (int)assigners.size();
+            for (int colIndex = 0; colIndex < count; colIndex++)
+            {
+                if (assigners[colIndex])
+                    assigners[colIndex](row, stmt, colIndex);
+            }
+            state = State::ROW;
+            return true;
+        }
+
+        sqlite3_stmt *stmt;
+        bool owned;
+        int resultCode;
+        State state;
+        std::vector<Internal::ColumnAssigner<SQLT_STRUCT>> assigners;
+        SQLT_STRUCT row;
+    };
+
+    /**
+     * Select all rows from a table for a given column (i.e. "SELECT member FROM SQLT_TABLE;").
+     *
+     * @tparam SQLT_DB The database to select from, defined by SQLT_DATABASE, SQLT_DATABASE_WITH_NAME or SQLT_DATABASE_WITH_NAME_AND_PATH.
+     * @tparam SQLT_TABLE The SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME to select from.
      * @param db The sqlite3 instance to select the rows from.
-     * @param selectQuery The SQLite SELECT query to perform to select rows into the output vector.
+     * @param member Pointer to the member in the SQLT_TABLE struct to select.
      * @param output The vector to save the results in. Will be resized to approximate_row_count in the process. Is expected to be empty, but the vector will not be cleared.
-     * @param approximate_row_count Optional number for initial vector.reserve() call. Should be equal to the expected row count if possible (if such information is available), to avoid unneccesary allocations.
+     * @param approximate_row_count Optional number for initial vector.reserve() call. Should be equal to or greater than the expected row count, if such information is available, to avoid unneccesary allocations.
      * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully selected.
      *
+     * @see SQLT::select(sqlite3 *db, const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
      * @see SQLT::select(const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
      * @see SQLT::selectAll(sqlite3 *db, std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
      * @see SQLT::selectAll(std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
-     * @see SQLT::select(sqlite3 *db, T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
      * @see SQLT::select(T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
      */
-    template<typename SQLT_QUERY_STRUCT>
-    inline int select(sqlite3 *db, const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
+    template<typename SQLT_DB, typename SQLT_TABLE, typename T>
+    inline int select(sqlite3 *db, T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
+    {
+        int result = SQLITE_ERROR;
+
+        std::string colName = SQLT::Internal::getColumnName<SQLT_TABLE>(member);
+        if (colName.size())
+        {
+            std::string query = SQLT::Internal::createSelectColumnPreparedStatement<SQLT_TABLE>(colName);
+
+            sqlite3_stmt *stmt;
+            result = sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, NULL);
+            if (result != SQLITE_OK)
+                return result;
+
+            result = SQLT::Internal::selectColumnValues(stmt, output, approximate_row_count);
+            if (result != SQLITE_OK)
+            {
+                sqlite3_finalize(stmt);
+                return result;
+            }
+
+            result = sqlite3_finalize(stmt);
+        }
+
+        return result;
+    }
+
+    /**
+     * Select all rows from a table for a given column (i.e. "SELECT member FROM SQLT_TABLE;") using a cached prepared statement.
+     *
+     * @tparam SQLT_TABLE The SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME to select from.
+     * @param cache The statement cache of the sqlite3 instance to select the rows from.
+     * @param member Pointer to the member in the SQLT_TABLE struct to select.
+     * @param output The vector to save the results in. Is expected to be empty, but the vector will not be cleared.
+     * @param approximate_row_count Optional number for initial vector.reserve() call. Should be equal to or greater than the expected row count, if such information is available, to avoid unneccesary allocations.
+     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully selected.
+     *
+     * @see SQLT::select(sqlite3 *db, T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
+     */
+    template<typename SQLT_TABLE, typename T>
+    inline int select(StatementCache& cache, T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
+    {
+        int result;
+        sqlite3_stmt *stmt;
+
+        const size_t position = SQLT::Internal::getColumnPosition<SQLT_TABLE>(member);
+        if (position == size_t(-1))
+            return SQLITE_ERROR;
+
+        const SQLT::Internal::StatementKey key(SQLT::Internal::tableKey<SQLT_TABLE>(), SQLT::Internal::StatementKind::SELECT_COLUMN, position);
+        result = cache.prepare(key, [member]() {
+            return SQLT::Internal::createSelectColumnPreparedStatement<SQLT_TABLE>(SQLT::Internal::getColumnName<SQLT_TABLE>(member));
+        }, &stmt);
+        if (result != SQLITE_OK)
+            return result;
+
+        result = SQLT::Internal::selectColumnValues(stmt, output, approximate_row_count);
+        sqlite3_reset(stmt);
+        return result;
+    }
+
+    /**
+     * Select all rows from a table for a given column (i.e. "SELECT member FROM SQLT_TABLE;").
+     *
+     * @tparam SQLT_DB The database to select from, defined by SQLT_DATABASE, SQLT_DATABASE_WITH_NAME or SQLT_DATABASE_WITH_NAME_AND_PATH.
+     * @tparam SQLT_TABLE The SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME to select from.
+     * @param member Pointer to the member in the SQLT_TABLE struct to select.
+     * @param output The vector to save the results in. Will be resized to approximate_row_count in the process. Is expected to be empty, but the vector will not be cleared.
+     * @param approximate_row_count Optional number for initial vector.reserve() call. Should be equal to or greater than the expected row count, if such information is available, to avoid unneccesary allocations.
+     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully selected.
+     *
+     * @see SQLT::select(sqlite3 *db, const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
+     * @see SQLT::select(const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
+     * @see SQLT::selectAll(sqlite3 *db, std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
+     * @see SQLT::selectAll(std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
+     * @see SQLT::select(sqlite3 *db, T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
+     */
+    template<typename SQLT_DB, typename SQLT_TABLE, typename T>
+    inline int select(T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
+    {
+        int result;
+        sqlite3 *db;
+        auto dbInfo = SQLT_DB::template SQLTDatabase<SQLT_DB>::sqlt_static_database_info();
+
+        result = sqlite3_open(dbInfo.dbFilePath().c_str(), &db);
+        if (result != SQLITE_OK)
+        {
+            sqlite3_close(db);
+            return result;
+        }
+
+        result = SQLT::select<SQLT_DB>(db, member, output);
+        if (result != SQLITE_OK)
+        {
+            sqlite3_close(db);
+            return result;
+        }
+
+        return sqlite3_close(db);
+    }
+
+    /**
+     * Execute a custom SQLite query.
+     *
+     * @param db The sqlite3 instance to execute the query on.
+     * @param query The SQLite query to perform. No results are returned
+     * @return The SQLite error code. Will be SQLITE_OK if the query was executed successfully.
+     */
+    inline int query(sqlite3 *db, const std::string& query)
     {
         int result = SQLITE_ERROR;
 
         sqlite3_stmt *stmt;
-        result = sqlite3_prepare_v2(db, selectQuery.c_str(), -1, &stmt, NULL);
+        result = sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, NULL);
         if (result != SQLITE_OK)
             return result;
 
-        if (output->size() < approximate_row_count)
-            output->reserve(approximate_row_count);
+        result = sqlite3_step(stmt);
+        if (result != SQLITE_DONE)
+        {
+            sqlite3_finalize(stmt);
+            return result;
+        }
+
+        result = sqlite3_finalize(stmt);
+        return result;
+    }
+
+    /**
+     * Execute a custom SQLite query with bound parameters.
+     *
+     * @param db The sqlite3 instance to execute the query on.
+     * @param query The SQLite query to perform, with ? parameters. No results are returned.
+     * @param arg The value of ?1.
+     * @param args The values of ?2, ?3, ... Any type that a column can have, as well as const char* and int64_t.
+     * @return The SQLite error code. Will be SQLITE_OK if the query was executed successfully.
+     *
+     * @see SQLT::query(StatementCache& cache, const std::string& query, const ARGS&... args)
+     */
+    template<typename ARG, typename... ARGS>
+    inline int query(sqlite3 *db, const std::string& query, const ARG& arg, const ARGS&... args)
+    {
+        int result;
+        sqlite3_stmt *stmt;
+
+        result = sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, NULL);
+        if (result != SQLITE_OK)
+            return result;
 
-        SQLT_QUERY_STRUCT row;
-        while (true)
+        result = Internal::bindParameters(stmt, params(arg, args...));
+        if (result == SQLITE_OK)
         {
             result = sqlite3_step(stmt);
-            if (result == SQLITE_ROW)
-            {
-                int count = sqlite3_column_count(stmt);
+            if (result == SQLITE_DONE)
+                result = SQLITE_OK;
+        }
 
-                if (count == 0)
-                    continue;
+        if (result != SQLITE_OK)
+        {
+            sqlite3_finalize(stmt);
+            return result;
+        }
 
-                for (int colIndex = 0; colIndex < count; colIndex++)
-                {
-                    const char* const colName = sqlite3_column_name(stmt, colIndex);
-                    Internal::iterateAndAssignMembersByColumnName(row, stmt, colName, colIndex);
-                }
+        return sqlite3_finalize(stmt);
+    }
 
-                output->emplace_back(row);
-            }
-            else if (result == SQLITE_DONE)
-            {
-                break;
-            }
-            else
-            {
-                sqlite3_finalize(stmt);
-                return result;
-            }
-        }
+    /**
+     * Execute a custom SQLite query with bound parameters using a statement cached by the SQL text.
+     *
+     * @param cache The statement cache of the sqlite3 instance to execute the query on.
+     * @param query The SQLite query to perform, with ? parameters. No results are returned.
+     * @param args The values of ?1, ?2, ... Any type that a column can have, as well as const char* and int64_t.
+     * @return The SQLite error code. Will be SQLITE_OK if the query was executed successfully.
+     *
+     * @see SQLT::query(sqlite3 *db, const std::string& query, const ARG& arg, const ARGS&... args)
+     */
+    template<typename... ARGS>
+    inline int query(StatementCache& cache, const std::string& query, const ARGS&... args)
+    {
+        int result;
+        sqlite3_stmt *stmt;
+
+        result = cache.prepare(query, &stmt);
+        if (result != SQLITE_OK)
+            return result;
 
-        result = sqlite3_finalize(stmt);
+        result = Internal::bindParameters(stmt, params(args...));
+        if (result == SQLITE_OK)
+        {
+            result = sqlite3_step(stmt);
+            if (result == SQLITE_DONE)
+                result = SQLITE_OK;
+        }
+        sqlite3_reset(stmt);
         return result;
     }
 
     /**
-     * Select rows from a custom SQLite query into the corresponding query struct.
+     * Update rows using a custom SQLite query.
      *
-     * @tparam SQLT_QUERY_STRUCT An SQLT query struct defined by SQLT_QUERY_RESULT_STRUCT.
      * @tparam SQLT_DB The database to select from, defined by SQLT_DATABASE, SQLT_DATABASE_WITH_NAME or SQLT_DATABASE_WITH_NAME_AND_PATH.
-     * @param selectQuery The SQLite SELECT query to perform to select rows into the output vector.
-     * @param output The vector to save the results in. Will be resized to approximate_row_count in the process. Is expected to be empty, but the vector will not be cleared.
-     * @param approximate_row_count Optional number for initial vector.reserve() call. Should be equal to the expected row count if possible (if such information is available), to avoid unneccesary allocations.
-     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully selected.
-     *
-     * @see SQLT::select(sqlite3 *db, const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
-     * @see SQLT::selectAll(sqlite3 *db, std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
-     * @see SQLT::selectAll(std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
-     * @see SQLT::select(sqlite3 *db, T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
-     * @see SQLT::select(T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
+     * @param query The SQLite query to perform. No results are returned.
+     * @return The SQLite error code. Will be SQLITE_OK if the query was executed successfully.
      */
-    template<typename SQLT_DB, typename SQLT_QUERY_STRUCT>
-    inline int select(const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
+    template<typename SQLT_DB>
+    inline int query(const std::string& query)
     {
         int result;
         sqlite3 *db;
@@ -1677,7 +4621,7 @@ namespace SQLT
             return result;
         }
 
-        result = SQLT::select<SQLT_QUERY_STRUCT>(db, selectQuery, output, approximate_row_count);
+        result = SQLT::query(db, query);
 
         if (result != SQLITE_OK)
         {
@@ -1690,263 +4634,423 @@ namespace SQLT
     }
 
     /**
-     * Select all rows from a table.
+     * Update rows in a table by their primary keys (i.e. "UPDATE table SET col1=?,... WHERE pk1=? AND ...;"). All
+     * non-primary key columns are set from the rows, and one prepared statement is used for all rows.
      *
      * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
-     * @param db The sqlite3 instance to select the rows from.
-     * @param output The vector to save the results in. Will be resized to approximate_row_count in the process. Is expected to be empty, but the vector will not be cleared.
-     * @param approximate_row_count Optional number for initial vector.reserve() call. Should be equal to or greater than the expected row count, if such information is available, to avoid unneccesary allocations.
-     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully selected.
+     * @param db The sqlite3 instance to update the rows in.
+     * @param rows The rows to update.
+     * @param changes Optional output for the total number of rows that were changed, also when an error occurs. Rows
+     *                whose primary key does not exist in the table are not changed.
+     * @return The SQLite error code. Will be SQLITE_OK if all rows were successfully updated. Will be SQLITE_MISUSE if
+     *         the table has no primary key.
      *
-     * @see SQLT::select(sqlite3 *db, const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
-     * @see SQLT::select(const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
-     * @see SQLT::selectAll(std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
-     * @see SQLT::select(sqlite3 *db, T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
-     * @see SQLT::select(T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
+     * @see SQLT::update(StatementCache& cache, const std::vector<SQLT_TABLE>& rows, int64_t *changes = nullptr)
      */
     template<typename SQLT_TABLE>
-    inline int selectAll(sqlite3 *db, std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
+    inline int update(sqlite3 *db, const std::vector<SQLT_TABLE>& rows, int64_t *changes = nullptr)
     {
         int result;
         sqlite3_stmt *stmt;
-        const std::string query = std::string("SELECT * FROM ") + SQLT::tableName<SQLT_TABLE>() + ";";
-        result = sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, NULL);
+        int64_t changed = 0;
+        if (changes)
+            *changes = 0;
+
+        const size_t pkCount = SQLT::Internal::primaryKeyCount<SQLT_TABLE>();
+        const size_t valueCount = SQLT::Internal::columnCount<SQLT_TABLE>() - pkCount;
+        if (pkCount == 0)
+            return SQLITE_MISUSE;
+        if (valueCount == 0 || rows.empty())
+            return SQLITE_OK;
+
+        const std::string& preparedStatement = SQLT::Internal::createUpdatePreparedStatement<SQLT_TABLE>();
+        result = sqlite3_prepare_v2(db, preparedStatement.c_str(), -1, &stmt, NULL);
         if (result != SQLITE_OK)
-        {
-            sqlite3_close(db);
             return result;
-        }
 
-        if (output->size() < approximate_row_count)
-            output->reserve(approximate_row_count);
+        result = SQLT::Internal::updateRows(stmt, SQLT::Internal::ColumnFilter::NON_PRIMARY_KEYS, (int)valueCount, rows.begin(), rows.end(), &changed);
+        if (changes)
+            *changes = changed;
 
-        SQLT_TABLE row;
-        while (true)
+        if (result != SQLITE_OK)
         {
-            result = sqlite3_step(stmt);
-            if (result == SQLITE_ROW)
-            {
-                SQLT::Internal::iterateAndAssignMembers(row, stmt);
-                output->emplace_back(row);
-            }
-            else if (result == SQLITE_DONE)
-            {
-                break;
-            }
-            else
-            {
-                sqlite3_finalize(stmt);
-                return result;
-            }
+            sqlite3_finalize(stmt);
+            return result;
         }
 
-        result = sqlite3_finalize(stmt);
-        return result;
+        return sqlite3_finalize(stmt);
     }
 
     /**
-     * Select all rows from a table.
+     * Update rows in a table by their primary keys using a cached prepared statement.
      *
-     * @tparam SQLT_DB The database to insert into, defined by SQLT_DATABASE, SQLT_DATABASE_WITH_NAME or SQLT_DATABASE_WITH_NAME_AND_PATH.
      * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
-     * @param output The vector to save the results in. Will be resized to approximate_row_count in the process. Is expected to be empty, but the vector will not be cleared.
-     * @param approximate_row_count Optional number for initial vector.reserve() call. Should be equal to or greater than the expected row count, if such information is available, to avoid unneccesary allocations.
-     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully selected.
+     * @param cache The statement cache of the sqlite3 instance to update the rows in.
+     * @param rows The rows to update.
+     * @param changes Optional output for the total number of rows that were changed, also when an error occurs.
+     * @return The SQLite error code. Will be SQLITE_OK if all rows were successfully updated. Will be SQLITE_MISUSE if
+     *         the table has no primary key.
      *
-     * @see SQLT::select(sqlite3 *db, const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
-     * @see SQLT::select(const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
-     * @see SQLT::selectAll(sqlite3 *db, std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
-     * @see SQLT::select(sqlite3 *db, T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
-     * @see SQLT::select(T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
+     * @see SQLT::update(sqlite3 *db, const std::vector<SQLT_TABLE>& rows, int64_t *changes = nullptr)
      */
-    template<typename SQLT_DB, typename SQLT_TABLE>
-    inline int selectAll(std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
+    template<typename SQLT_TABLE>
+    inline int update(StatementCache& cache, const std::vector<SQLT_TABLE>& rows, int64_t *changes = nullptr)
     {
         int result;
-        sqlite3 *db;
-        auto dbInfo = SQLT_DB::template SQLTDatabase<SQLT_DB>::sqlt_static_database_info();
+        sqlite3_stmt *stmt;
+        int64_t changed = 0;
+        if (changes)
+            *changes = 0;
+
+        const size_t pkCount = SQLT::Internal::primaryKeyCount<SQLT_TABLE>();
+        const size_t valueCount = SQLT::Internal::columnCount<SQLT_TABLE>() - pkCount;
+        if (pkCount == 0)
+            return SQLITE_MISUSE;
+        if (valueCount == 0 || rows.empty())
+            return SQLITE_OK;
+
+        const SQLT::Internal::StatementKey key(SQLT::Internal::tableKey<SQLT_TABLE>(), SQLT::Internal::StatementKind::UPDATE);
+        result = cache.prepare(key, &SQLT::Internal::createUpdatePreparedStatement<SQLT_TABLE>, &stmt);
+        if (result != SQLITE_OK)
+            return result;
 
-        result = sqlite3_open(dbInfo.dbFilePath().c_str(), &db);
+        result = SQLT::Internal::updateRows(stmt, SQLT::Internal::ColumnFilter::NON_PRIMARY_KEYS, (int)valueCount, rows.begin(), rows.end(), &changed);
+        sqlite3_reset(stmt);
+        if (changes)
+            *changes = changed;
+        return result;
+    }
+
+    /**
+     * Update some of the columns of rows in a table by their primary keys, e.g.
+     * SQLT::updateColumns(db, rows, &changes, &Table::value, &Table::enabled) for
+     * "UPDATE Table SET value=?,enabled=? WHERE id=?;". Only the given members and the primary key are bound.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param db The sqlite3 instance to update the rows in.
+     * @param rows The rows to update.
+     * @param changes Optional output for the total number of rows that were changed, also when an error occurs.
+     * @param member, members Pointers to the members of the columns to set.
+     * @return The SQLite error code. Will be SQLITE_OK if all rows were successfully updated. Will be SQLITE_MISUSE if
+     *         the table has no primary key or a member is not a column of the table.
+     *
+     * @see SQLT::update(sqlite3 *db, const std::vector<SQLT_TABLE>& rows, int64_t *changes = nullptr)
+     */
+    template<typename SQLT_TABLE, typename T, typename... MEMBERS>
+    inline int updateColumns(sqlite3 *db, const std::vector<SQLT_TABLE>& rows, int64_t *changes, T SQLT_TABLE::* member, MEMBERS... members)
+    {
+        int result;
+        sqlite3_stmt *stmt;
+        int64_t changed = 0;
+        if (changes)
+            *changes = 0;
+
+        size_t mask = 0;
+        if (SQLT::Internal::primaryKeyCount<SQLT_TABLE>() == 0 || !SQLT::Internal::addColumnsToMask<SQLT_TABLE>(mask, member, members...))
+            return SQLITE_MISUSE;
+        if (rows.empty())
+            return SQLITE_OK;
+
+        const SQLT::Internal::ColumnSelection columns(SQLT::Internal::ColumnFilter::POSITION_MASK, mask);
+        const std::string preparedStatement = SQLT::Internal::createUpdateColumnsPreparedStatement<SQLT_TABLE>(columns);
+        result = sqlite3_prepare_v2(db, preparedStatement.c_str(), -1, &stmt, NULL);
         if (result != SQLITE_OK)
-        {
-            sqlite3_close(db);
             return result;
-        }
 
-        result = SQLT::selectAll<SQLT_TABLE>(db, output, approximate_row_count);
+        result = SQLT::Internal::updateRows(stmt, columns, sqlite3_bind_parameter_count(stmt) - (int)SQLT::Internal::primaryKeyCount<SQLT_TABLE>(), rows.begin(), rows.end(), &changed);
+        if (changes)
+            *changes = changed;
+
         if (result != SQLITE_OK)
         {
-            sqlite3_close(db);
+            sqlite3_finalize(stmt);
             return result;
         }
 
-        return sqlite3_close(db);
+        return sqlite3_finalize(stmt);
     }
 
     /**
-     * Select all rows from a table for a given column (i.e. "SELECT member FROM SQLT_TABLE;").
-     *
-     * @tparam SQLT_DB The database to select from, defined by SQLT_DATABASE, SQLT_DATABASE_WITH_NAME or SQLT_DATABASE_WITH_NAME_AND_PATH.
-     * @tparam SQLT_TABLE The SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME to select from.
-     * @param db The sqlite3 instance to select the rows from.
-     * @param member Pointer to the member in the SQLT_TABLE struct to select.
-     * @param output The vector to save the results in. Will be resized to approximate_row_count in the process. Is expected to be empty, but the vector will not be cleared.
-     * @param approximate_row_count Optional number for initial vector.reserve() call. Should be equal to or greater than the expected row count, if such information is available, to avoid unneccesary allocations.
-     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully selected.
+     * Update some of the columns of rows in a table by their primary keys.
      *
-     * @see SQLT::select(sqlite3 *db, const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
-     * @see SQLT::select(const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
-     * @see SQLT::selectAll(sqlite3 *db, std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
-     * @see SQLT::selectAll(std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
-     * @see SQLT::select(T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
+     * @see SQLT::updateColumns(sqlite3 *db, const std::vector<SQLT_TABLE>& rows, int64_t *changes, T SQLT_TABLE::* member, MEMBERS... members)
      */
-    template<typename SQLT_DB, typename SQLT_TABLE, typename T>
-    inline int select(sqlite3 *db, T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
+    template<typename SQLT_TABLE, typename T, typename... MEMBERS>
+    inline int updateColumns(sqlite3 *db, const std::vector<SQLT_TABLE>& rows, T SQLT_TABLE::* member, MEMBERS... members)
     {
-        int result = SQLITE_ERROR;
-
-        if (output->size() < approximate_row_count)
-            output->reserve(approximate_row_count);
-
-        std::string colName = SQLT::Internal::getColumnName<SQLT_TABLE>(member);
-        if (colName.size())
-        {
-            std::string tableName = SQLT::tableName<SQLT_TABLE>();
-            std::string query = "SELECT " + colName + " FROM " + tableName + ";";
-
-            sqlite3_stmt *stmt;
-            result = sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, NULL);
-            if (result == SQLITE_OK)
-            {
-                T selectedValue;
-                while (true)
-                {
-                    result = sqlite3_step(stmt);
-                    if (result == SQLITE_ROW)
-                    {
-                        SQLT::Internal::assignValue(selectedValue, stmt);
-                        output->emplace_back(selectedValue);
-                    }
-                    else if (result == SQLITE_DONE)
-                    {
-                        break;
-                    }
-                    else
-                    {
-                        sqlite3_finalize(stmt);
-                        return result;
-                    }
-                }
-            }
-            else
-            {
-                sqlite3_finalize(stmt);
-                return result;
-            }
+        return SQLT::updateColumns(db, rows, nullptr, member, members...);
+    }
 
-            result = sqlite3_finalize(stmt);
-        }
+    /**
+     * Update some of the columns of rows in a table by their primary keys using a cached prepared statement. One
+     * statement is cached for each combination of columns.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param cache The statement cache of the sqlite3 instance to update the rows in.
+     * @param rows The rows to update.
+     * @param changes Optional output for the total number of rows that were changed, also when an error occurs.
+     * @param member, members Pointers to the members of the columns to set.
+     * @return The SQLite error code. Will be SQLITE_OK if all rows were successfully updated. Will be SQLITE_MISUSE if
+     *         the table has no primary key or a member is not a column of the table.
+     *
+     * @see SQLT::updateColumns(sqlite3 *db, const std::vector<SQLT_TABLE>& rows, int64_t *changes, T SQLT_TABLE::* member, MEMBERS... members)
+     */
+    template<typename SQLT_TABLE, typename T, typename... MEMBERS>
+    inline int updateColumns(StatementCache& cache, const std::vector<SQLT_TABLE>& rows, int64_t *changes, T SQLT_TABLE::* member, MEMBERS... members)
+    {
+        int result;
+        sqlite3_stmt *stmt;
+        int64_t changed = 0;
+        if (changes)
+            *changes = 0;
+
+        size_t mask = 0;
+        if (SQLT::Internal::primaryKeyCount<SQLT_TABLE>() == 0 || !SQLT::Internal::addColumnsToMask<SQLT_TABLE>(mask, member, members...))
+            return SQLITE_MISUSE;
+        if (rows.empty())
+            return SQLITE_OK;
+
+        const SQLT::Internal::ColumnSelection columns(SQLT::Internal::ColumnFilter::POSITION_MASK, mask);
+        const SQLT::Internal::StatementKey key(SQLT::Internal::tableKey<SQLT_TABLE>(), SQLT::Internal::StatementKind::UPDATE_COLUMNS, mask);
+        result = cache.prepare(key, [&columns]() { return SQLT::Internal::createUpdateColumnsPreparedStatement<SQLT_TABLE>(columns); }, &stmt);
+        if (result != SQLITE_OK)
+            return result;
 
+        result = SQLT::Internal::updateRows(stmt, columns, sqlite3_bind_parameter_count(stmt) - (int)SQLT::Internal::primaryKeyCount<SQLT_TABLE>(), rows.begin(), rows.end(), &changed);
+        sqlite3_reset(stmt);
+        if (changes)
+            *changes = changed;
         return result;
     }
 
     /**
-     * Select all rows from a table for a given column (i.e. "SELECT member FROM SQLT_TABLE;").
+     * Update some of the columns of rows in a table by their primary keys using a cached prepared statement.
      *
-     * @tparam SQLT_DB The database to select from, defined by SQLT_DATABASE, SQLT_DATABASE_WITH_NAME or SQLT_DATABASE_WITH_NAME_AND_PATH.
-     * @tparam SQLT_TABLE The SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME to select from.
-     * @param member Pointer to the member in the SQLT_TABLE struct to select.
-     * @param output The vector to save the results in. Will be resized to approximate_row_count in the process. Is expected to be empty, but the vector will not be cleared.
-     * @param approximate_row_count Optional number for initial vector.reserve() call. Should be equal to or greater than the expected row count, if such information is available, to avoid unneccesary allocations.
-     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully selected.
+     * @see SQLT::updateColumns(StatementCache& cache, const std::vector<SQLT_TABLE>& rows, int64_t *changes, T SQLT_TABLE::* member, MEMBERS... members)
+     */
+    template<typename SQLT_TABLE, typename T, typename... MEMBERS>
+    inline int updateColumns(StatementCache& cache, const std::vector<SQLT_TABLE>& rows, T SQLT_TABLE::* member, MEMBERS... members)
+    {
+        return SQLT::updateColumns(cache, rows, nullptr, member, members...);
+    }
+
+    /**
+     * Delete rows from a table with a single column primary key by their keys. The keys are deleted in chunks of bound
+     * "DELETE FROM table WHERE pk IN (?,?,...);" statements within one transaction (a savepoint, so it may be called
+     * inside an open transaction). If a chunk fails, all chunks are rolled back.
      *
-     * @see SQLT::select(sqlite3 *db, const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
-     * @see SQLT::select(const std::string& selectQuery, std::vector<SQLT_QUERY_STRUCT> *output, size_t approximate_row_count = 50)
-     * @see SQLT::selectAll(sqlite3 *db, std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
-     * @see SQLT::selectAll(std::vector<SQLT_TABLE> *output, size_t approximate_row_count = 50)
-     * @see SQLT::select(sqlite3 *db, T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @tparam KEY The type of the primary key column. Other integer types are bound as int64_t and floating point types as double.
+     * @param db The sqlite3 instance to delete the rows in.
+     * @param keys The primary keys of the rows to delete.
+     * @param deleted Optional output for the number of rows that were deleted. Keys that do not exist are not counted.
+     * @param maxKeysPerStatement The maximum number of keys per DELETE statement.
+     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully deleted. Will be SQLITE_MISUSE if
+     *         the primary key of the table is not a single column.
+     *
+     * @see SQLT::deleteByKeys(sqlite3 *db, const std::vector<SQLT_TABLE>& keyRows, int64_t *deleted = nullptr, size_t maxKeysPerStatement = 500)
      */
-    template<typename SQLT_DB, typename SQLT_TABLE, typename T>
-    inline int select(T SQLT_TABLE::* member, std::vector<T> *output, size_t approximate_row_count = 50)
+    template<typename SQLT_TABLE, typename KEY, typename = typename std::enable_if<!std::is_same<KEY, SQLT_TABLE>::value>::type>
+    inline int deleteByKeys(sqlite3 *db, const std::vector<KEY>& keys, int64_t *deleted = nullptr, size_t maxKeysPerStatement = 500)
     {
+        typedef typename SQLT::Internal::ParameterType<KEY>::type BOUND_KEY;
+        static_assert(SQLT::Internal::HasValueBinder<BOUND_KEY>::value, "Keys must be of a column type, const char*, an integer or a floating point type.");
+
         int result;
-        sqlite3 *db;
-        auto dbInfo = SQLT_DB::template SQLTDatabase<SQLT_DB>::sqlt_static_database_info();
+        int64_t deletedRows = 0;
+        if (deleted)
+            *deleted = 0;
 
-        result = sqlite3_open(dbInfo.dbFilePath().c_str(), &db);
-        if (result != SQLITE_OK)
-        {
-            sqlite3_close(db);
-            return result;
-        }
+        if (SQLT::Internal::primaryKeyCount<SQLT_TABLE>() != 1)
+            return SQLITE_MISUSE;
+        if (keys.empty())
+            return SQLITE_OK;
 
-        result = SQLT::select<SQLT_DB>(db, member, output);
+        result = SQLT::Internal::beginSavepoint(db, "sqlt_delete_by_keys");
         if (result != SQLITE_OK)
-        {
-            sqlite3_close(db);
             return result;
-        }
 
-        return sqlite3_close(db);
+        result = SQLT::Internal::deleteKeys<SQLT_TABLE>(db, keys.size(), maxKeysPerStatement, [&keys](sqlite3_stmt *stmt, size_t index, int offset) {
+            return SQLT::Internal::SQLiteValueBinder<BOUND_KEY>::bindValue(stmt, offset + 1, keys[index]);
+        }, &deletedRows);
+
+        const int endResult = SQLT::Internal::endSavepoint(db, "sqlt_delete_by_keys", result == SQLITE_OK);
+        if (result == SQLITE_OK)
+            result = endResult;
+        if (deleted && result == SQLITE_OK)
+            *deleted = deletedRows;
+        return result;
     }
 
     /**
-     * Execute a custom SQLite query.
+     * Delete rows from a table by their primary keys. Only the primary key members of the key rows are used, so this
+     * works for composite primary keys as well. The keys are deleted in chunks of bound
+     * "DELETE FROM table WHERE (pk1,pk2) IN (VALUES(?,?),...);" statements within one transaction (a savepoint, so it
+     * may be called inside an open transaction). If a chunk fails, all chunks are rolled back.
      *
-     * @param db The sqlite3 instance to execute the query on.
-     * @param query The SQLite query to perform. No results are returned
-     * @return The SQLite error code. Will be SQLITE_OK if the query was executed successfully.
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param db The sqlite3 instance to delete the rows in.
+     * @param keyRows Rows holding the primary keys of the rows to delete.
+     * @param deleted Optional output for the number of rows that were deleted. Keys that do not exist are not counted.
+     * @param maxKeysPerStatement The maximum number of keys per DELETE statement.
+     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully deleted. Will be SQLITE_MISUSE if
+     *         the table has no primary key.
+     *
+     * @see SQLT::deleteByKeys(sqlite3 *db, const std::vector<KEY>& keys, int64_t *deleted = nullptr, size_t maxKeysPerStatement = 500)
      */
-    inline int query(sqlite3 *db, const std::string& query)
+    template<typename SQLT_TABLE>
+    inline int deleteByKeys(sqlite3 *db, const std::vector<SQLT_TABLE>& keyRows, int64_t *deleted = nullptr, size_t maxKeysPerStatement = 500)
     {
-        int result = SQLITE_ERROR;
+        int result;
+        int64_t deletedRows = 0;
+        if (deleted)
+            *deleted = 0;
 
-        sqlite3_stmt *stmt;
-        result = sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, NULL);
+        if (SQLT::Internal::primaryKeyCount<SQLT_TABLE>() == 0)
+            return SQLITE_MISUSE;
+        if (keyRows.empty())
+            return SQLITE_OK;
+
+        result = SQLT::Internal::beginSavepoint(db, "sqlt_delete_by_keys");
         if (result != SQLITE_OK)
             return result;
 
-        result = sqlite3_step(stmt);
-        if (result != SQLITE_DONE)
-        {
-            sqlite3_finalize(stmt);
-            return result;
-        }
+        result = SQLT::Internal::deleteKeys<SQLT_TABLE>(db, keyRows.size(), maxKeysPerStatement, [&keyRows](sqlite3_stmt *stmt, size_t index, int offset) {
+            return SQLT::Internal::iterateAndBindFilteredValues(keyRows[index], stmt, SQLT::Internal::ColumnFilter::PRIMARY_KEYS, offset);
+        }, &deletedRows);
 
-        result = sqlite3_finalize(stmt);
+        const int endResult = SQLT::Internal::endSavepoint(db, "sqlt_delete_by_keys", result == SQLITE_OK);
+        if (result == SQLITE_OK)
+            result = endResult;
+        if (deleted && result == SQLITE_OK)
+            *deleted = deletedRows;
         return result;
     }
 
     /**
-     * Update rows using a custom SQLite query.
+     * The number of rows written by SQLT::sync().
+     */
+    struct SyncCounts
+    {
+        SyncCounts()
+            : inserted(0)
+            , updated(0)
+            , deleted(0)
+        {}
+
+        size_t inserted;
+        size_t updated;
+        size_t deleted;
+    };
+
+    /**
+     * Write the difference between two states of a table to the database. Rows are matched by primary key: rows only in
+     * previous are deleted, rows only in current are inserted and rows whose other columns differ are updated. Rows
+     * that did not change are not written. All changes are made in one transaction (a savepoint, so it may be called
+     * inside an open transaction) and rolled back if one of them fails.
      *
-     * @tparam SQLT_DB The database to select from, defined by SQLT_DATABASE, SQLT_DATABASE_WITH_NAME or SQLT_DATABASE_WITH_NAME_AND_PATH.
-     * @param query The SQLite query to perform. No results are returned.
-     * @return The SQLite error code. Will be SQLITE_OK if the query was executed successfully.
+     * previous is expected to match the table, e.g. the current of the last call or the result of a selectAll. The
+     * primary keys within each vector must be unique.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param db The sqlite3 instance to write the changes to.
+     * @param previous The rows as they are in the table.
+     * @param current The rows as they should be in the table.
+     * @param counts Optional output for the number of rows that were inserted, updated and deleted.
+     * @return The SQLite error code. Will be SQLITE_OK if all changes were written. Will be SQLITE_MISUSE if the table
+     *         has no primary key.
      */
-    template<typename SQLT_DB>
-    inline int query(const std::string& query)
+    template<typename SQLT_TABLE>
+    inline int sync(sqlite3 *db, const std::vector<SQLT_TABLE>& previous, const std::vector<SQLT_TABLE>& current, SyncCounts *counts = nullptr)
     {
+        typedef const SQLT_TABLE *RowPointer;
         int result;
-        sqlite3 *db;
-        auto dbInfo = SQLT_DB::template SQLTDatabase<SQLT_DB>::sqlt_static_database_info();
+        if (counts)
+            *counts = SyncCounts();
 
-        result = sqlite3_open(dbInfo.dbFilePath().c_str(), &db);
+        const size_t pkCount = SQLT::Internal::primaryKeyCount<SQLT_TABLE>();
+        const size_t valueCount = SQLT::Internal::columnCount<SQLT_TABLE>() - pkCount;
+        if (pkCount == 0)
+            return SQLITE_MISUSE;
+
+        const auto byKey = [](RowPointer a, RowPointer b) {
+            return SQLT::Internal::compareRows(*a, *b, SQLT::Internal::ColumnFilter::PRIMARY_KEYS) < 0;
+        };
+        std::vector<RowPointer> before, after;
+        before.reserve(previous.size());
+        after.reserve(current.size());
+        for (const auto& row : previous)
+            before.push_back(&row);
+        for (const auto& row : current)
+            after.push_back(&row);
+        std::sort(before.begin(), before.end(), byKey);
+        std::sort(after.begin(), after.end(), byKey);
+
+        std::vector<RowPointer> inserts, updates, deletes;
+        auto b = before.begin();
+        auto a = after.begin();
+        while (b != before.end() || a != after.end())
+        {
+            const int order = (b == before.end()) ? 1 : (a == after.end()) ? -1 :
+                              SQLT::Internal::compareRows(**b, **a, SQLT::Internal::ColumnFilter::PRIMARY_KEYS);
+            if (order < 0)
+            {
+                deletes.push_back(*b++);
+            }
+            else if (order > 0)
+            {
+                inserts.push_back(*a++);
+            }
+            else
+            {
+                if (SQLT::Internal::compareRows(**b, **a, SQLT::Internal::ColumnFilter::NON_PRIMARY_KEYS) != 0)
+                    updates.push_back(*a);
+                ++b;
+                ++a;
+            }
+        }
+
+        if (inserts.empty() && updates.empty() && deletes.empty())
+            return SQLITE_OK;
+
+        result = SQLT::Internal::beginSavepoint(db, "sqlt_sync");
         if (result != SQLITE_OK)
-        {
-            sqlite3_close(db);
             return result;
+
+        int64_t deleted = 0;
+        int64_t updated = 0;
+        if (!deletes.empty())
+        {
+            result = SQLT::Internal::deleteKeys<SQLT_TABLE>(db, deletes.size(), 500, [&deletes](sqlite3_stmt *stmt, size_t index, int offset) {
+                return SQLT::Internal::iterateAndBindFilteredValues(*deletes[index], stmt, SQLT::Internal::ColumnFilter::PRIMARY_KEYS, offset);
+            }, &deleted);
+        }
+
+        if (result == SQLITE_OK && !updates.empty())
+        {
+            sqlite3_stmt *stmt;
+            const std::string& preparedStatement = SQLT::Internal::createUpdatePreparedStatement<SQLT_TABLE>();
+            result = sqlite3_prepare_v2(db, preparedStatement.c_str(), -1, &stmt, NULL);
+            if (result == SQLITE_OK)
+            {
+                result = SQLT::Internal::updateRows(stmt, SQLT::Internal::ColumnFilter::NON_PRIMARY_KEYS, (int)valueCount, updates.begin(), updates.end(), &updated);
+                sqlite3_finalize(stmt);
+            }
         }
 
-        result = SQLT::query(db, query);
+        if (result == SQLITE_OK && !inserts.empty())
+            result = SQLT::insert(db, inserts.begin(), inserts.end());
+
+        const int endResult = SQLT::Internal::endSavepoint(db, "sqlt_sync", result == SQLITE_OK);
+        if (result == SQLITE_OK)
+            result = endResult;
 
-        if (result != SQLITE_OK)
+        if (counts && result == SQLITE_OK)
         {
-            sqlite3_close(db);
-            return result;
+            counts->inserted = inserts.size();
+            counts->updated = (size_t)updated;
+            counts->deleted = (size_t)deleted;
         }
-
-        result = sqlite3_close(db);
         return result;
     }
 
@@ -1962,7 +5066,7 @@ namespace SQLT
     {
         int result = SQLITE_ERROR;
         sqlite3_stmt *stmt;
-        const std::string preparedStatement = SQLT::Internal::createDeleteAllPreparedStatement<SQLT_TABLE>();
+        const std::string& preparedStatement = SQLT::Internal::createDeleteAllPreparedStatement<SQLT_TABLE>();
 
         result = sqlite3_prepare_v2(db, preparedStatement.c_str(), -1, &stmt, NULL);
         if (result != SQLITE_OK)
@@ -1979,6 +5083,31 @@ namespace SQLT
         return result;
     }
 
+    /**
+     * Delete all data in a table using a cached prepared statement.
+     *
+     * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+     * @param cache The statement cache of the sqlite3 instance to delete data in.
+     * @return The SQLite error code. Will be SQLITE_OK if the rows were successfully deleted.
+     *
+     * @see SQLT::deleteAll(sqlite3 *db)
+     */
+    template<typename SQLT_TABLE>
+    inline int deleteAll(StatementCache& cache)
+    {
+        int result;
+        sqlite3_stmt *stmt;
+        const SQLT::Internal::StatementKey key(SQLT::Internal::tableKey<SQLT_TABLE>(), SQLT::Internal::StatementKind::DELETE_ALL);
+
+        result = cache.prepare(key, &SQLT::Internal::createDeleteAllPreparedStatement<SQLT_TABLE>, &stmt);
+        if (result != SQLITE_OK)
+            return result;
+
+        result = sqlite3_step(stmt);
+        sqlite3_reset(stmt);
+        return (result == SQLITE_DONE) ? SQLITE_OK : result;
+    }
+
     /**
      * SQLT Internal namespace. Should normally not be referenced externally.
      */
@@ -2079,7 +5208,7 @@ namespace SQLT
 #define SQLT_COLUMN_FLAGS(member, flags) SQLT::Internal::makeColumnInfo(#member, &SQLT_STRUCT_T::member, flags)
 #define SQLT_COLUMN_FLAGS_DEFAULT(member, default, flags) SQLT::Internal::makeColumnInfo(#member, &SQLT_STRUCT_T::member, default, flags | SQLT::Flags::DEFAULT)
 
-#define SQLT_TABLE_WITH_NAME(SQLT_TABLE_STRUCT, table_name, ...) \
+#define SQLT_TABLE_WITH_NAME_AND_ROWID(SQLT_TABLE_STRUCT, table_name, without_rowid, ...) \
     template<typename SQLT_STRUCT_T> \
     struct SQLTBase \
     { \
@@ -2088,6 +5217,10 @@ namespace SQLT
             static auto ret = SQLT::Internal::makeTableName(table_name); \
             return ret; \
         } \
+        static constexpr bool sqlt_static_without_rowid() \
+        { \
+            return without_rowid; \
+        } \
         using CT = decltype(SQLT::Internal::makeTuple(__VA_ARGS__)); \
         static const CT &sqlt_static_column_info() \
         { \
@@ -2096,9 +5229,20 @@ namespace SQLT
         } \
     };
 
+#define SQLT_TABLE_WITH_NAME(SQLT_TABLE_STRUCT, table_name, ...) \
+    SQLT_TABLE_WITH_NAME_AND_ROWID(SQLT_TABLE_STRUCT, table_name, false, __VA_ARGS__)
+
 #define SQLT_TABLE(SQLT_TABLE_STRUCT, ...) \
     SQLT_TABLE_WITH_NAME(SQLT_TABLE_STRUCT, #SQLT_TABLE_STRUCT, __VA_ARGS__)
 
+// Tables created WITHOUT ROWID are stored in a single B-tree ordered by the primary key instead of a rowid B-tree plus
+// a primary key index. Requires at least one primary key column. See https://www.sqlite.org/withoutrowid.html.
+#define SQLT_TABLE_WITH_NAME_WITHOUT_ROWID(SQLT_TABLE_STRUCT, table_name, ...) \
+    SQLT_TABLE_WITH_NAME_AND_ROWID(SQLT_TABLE_STRUCT, table_name, true, __VA_ARGS__)
+
+#define SQLT_TABLE_WITHOUT_ROWID(SQLT_TABLE_STRUCT, ...) \
+    SQLT_TABLE_WITH_NAME_WITHOUT_ROWID(SQLT_TABLE_STRUCT, #SQLT_TABLE_STRUCT, __VA_ARGS__)
+
 #define SQLT_QUERY_RESULT_MEMBER(member) \
     SQLT::Internal::makeColumnInfo(#member, &SQLT_STRUCT_T::member, SQLT::Flags::NONE)
 
@@ -2179,6 +5323,221 @@ namespace SQLT
         return sqlite3_exec(db, "COMMIT", 0, 0, 0);
     }
 
+    /**
+     * Puts a connection in a fast, non-durable mode for initial imports and restores it when the session ends.
+     *
+     * On entry the session saves and sets "PRAGMA synchronous=OFF", "PRAGMA journal_mode=MEMORY",
+     * "PRAGMA locking_mode=EXCLUSIVE" and a large "PRAGMA cache_size", and drops all secondary indexes in the database.
+     * Indexes added with createIndex() are deferred as well. When the session ends (finish() or the destructor) the
+     * indexes are built, the settings are restored and the exclusive lock is released.
+     *
+     * The connection holds an exclusive lock during the session, so all work must go through db(), e.g.
+     * SQLT::createAllTables<SQLT_DB>(session.db(), &errMsg) and SQLT::bulkInsert(session.db(), rows). A crash or power
+     * loss during the session can corrupt the database, so only use it for data that can be loaded again.
+     *
+     * @tparam SQLT_DB The database to load, defined by SQLT_DATABASE, SQLT_DATABASE_WITH_NAME or SQLT_DATABASE_WITH_NAME_AND_PATH.
+     */
+    template<typename SQLT_DB>
+    class BulkLoadSession
+    {
+    public:
+        /**
+         * Open a connection to the database and start the session on it. The connection is closed when the session ends.
+         *
+         * @param cacheSize The "PRAGMA cache_size" during the session. Negative values are in KiB, positive in pages.
+         */
+        explicit BulkLoadSession(int cacheSize = -262144)
+            : database(nullptr)
+            , ownsDatabase(true)
+            , finished(false)
+        {
+            startResult = SQLT::open<SQLT_DB>(&database);
+            if (startResult != SQLITE_OK)
+            {
+                database = nullptr;
+                finished = true;
+                return;
+            }
+            startResult = start(cacheSize);
+        }
+
+        /**
+         * Start the session on an open connection. The connection is left open when the session ends.
+         *
+         * @param db The sqlite3 instance to load the database with. Must not be in a transaction.
+         * @param cacheSize The "PRAGMA cache_size" during the session. Negative values are in KiB, positive in pages.
+         */
+        explicit BulkLoadSession(sqlite3 *db, int cacheSize = -262144)
+            : database(db)
+            , ownsDatabase(false)
+            , finished(false)
+        {
+            startResult = start(cacheSize);
+        }
+
+        /**
+         * End the session if finish() has not been called.
+         */
+        ~BulkLoadSession()
+        {
+            finish();
+        }
+
+        BulkLoadSession(const BulkLoadSession&) = delete;
+        BulkLoadSession& operator=(const BulkLoadSession&) = delete;
+
+        /**
+         * @return The connection to use during the session.
+         */
+        sqlite3 *db() const { return database; }
+
+        /**
+         * @return The SQLite error code of starting the session. Will be SQLITE_OK if the session was started.
+         */
+        int status() const { return startResult; }
+
+        /**
+         * Defer an index until the session ends.
+         *
+         * @param createIndexStatement The statement creating the index, e.g. "CREATE INDEX ix_name ON Table(column);".
+         */
+        void createIndex(const std::string& createIndexStatement)
+        {
+            indexes.push_back(std::make_pair(std::string(), createIndexStatement));
+        }
+
+        /**
+         * Build the deferred indexes, restore the settings of the connection and release the exclusive lock. Only the
+         * first call has any effect.
+         *
+         * @return The SQLite error code. Will be SQLITE_OK if all indexes were built and all settings restored.
+         */
+        int finish()
+        {
+            if (finished)
+                return SQLITE_OK;
+            finished = true;
+
+            int result = SQLITE_OK;
+            int stepResult;
+            for (const auto& index : indexes)
+            {
+                // Indexes that were dropped on entry may have been created again during the session.
+                if (!index.first.empty() && indexExists(index.first))
+                    continue;
+                stepResult = sqlite3_exec(database, index.second.c_str(), NULL, NULL, NULL);
+                if (result == SQLITE_OK)
+                    result = stepResult;
+            }
+            indexes.clear();
+
+            for (const auto& pragma : pragmas)
+            {
+                const std::string statement = "PRAGMA " + pragma.first + "=" + pragma.second + ";";
+                stepResult = sqlite3_exec(database, statement.c_str(), NULL, NULL, NULL);
+                if (result == SQLITE_OK)
+                    result = stepResult;
+            }
+            pragmas.clear();
+
+            // The exclusive lock is released the next time the database is read.
+            stepResult = sqlite3_exec(database, "SELECT COUNT(*) FROM sqlite_master;", NULL, NULL, NULL);
+            if (result == SQLITE_OK)
+                result = stepResult;
+
+            if (ownsDatabase)
+            {
+                stepResult = SQLT::close<SQLT_DB>(database);
+                if (result == SQLITE_OK)
+                    result = stepResult;
+                database = nullptr;
+            }
+            return result;
+        }
+
+    private:
+        int start(int cacheSize)
+        {
+            int result;
+            const char *names[] = { "journal_mode", "locking_mode", "synchronous", "cache_size" };
+            const std::string values[] = { "MEMORY", "EXCLUSIVE", "OFF", std::to_string(cacheSize) };
+            for (size_t i = 0; i < 4; i++)
+            {
+                std::string previous;
+                result = pragmaValue(names[i], &previous);
+                if (result != SQLITE_OK)
+                    return result;
+                pragmas.push_back(std::make_pair(std::string(names[i]), previous));
+
+                const std::string statement = std::string("PRAGMA ") + names[i] + "=" + values[i] + ";";
+                result = sqlite3_exec(database, statement.c_str(), NULL, NULL, NULL);
+                if (result != SQLITE_OK)
+                    return result;
+            }
+
+            // Auto indexes (primary keys and unique constraints) have no SQL and cannot be dropped.
+            sqlite3_stmt *stmt;
+            result = sqlite3_prepare_v2(database, "SELECT name, sql FROM sqlite_master WHERE type = 'index' AND sql IS NOT NULL;", -1, &stmt, NULL);
+            if (result != SQLITE_OK)
+                return result;
+            while ((result = sqlite3_step(stmt)) == SQLITE_ROW)
+            {
+                indexes.push_back(std::make_pair(
+                    std::string(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0))),
+                    std::string(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1)))));
+            }
+            sqlite3_finalize(stmt);
+            if (result != SQLITE_DONE)
+                return result;
+
+            for (const auto& index : indexes)
+            {
+                const std::string statement = "DROP INDEX \"" + index.first + "\";";
+                result = sqlite3_exec(database, statement.c_str(), NULL, NULL, NULL);
+                if (result != SQLITE_OK)
+                    return result;
+            }
+            return SQLITE_OK;
+        }
+
+        int pragmaValue(const char *name, std::string *value)
+        {
+            sqlite3_stmt *stmt;
+            const std::string statement = std::string("PRAGMA ") + name + ";";
+            int result = sqlite3_prepare_v2(database, statement.c_str(), -1, &stmt, NULL);
+            if (result != SQLITE_OK)
+                return result;
+
+            result = sqlite3_step(stmt);
+            if (result == SQLITE_ROW)
+            {
+                *value = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+                result = SQLITE_OK;
+            }
+            sqlite3_finalize(stmt);
+            return result;
+        }
+
+        bool indexExists(const std::string& name)
+        {
+            sqlite3_stmt *stmt;
+            bool exists = false;
+            if (sqlite3_prepare_v2(database, "SELECT 1 FROM sqlite_master WHERE type = 'index' AND name = ?;", -1, &stmt, NULL) != SQLITE_OK)
+                return false;
+            sqlite3_bind_text(stmt, 1, name.c_str(), (int)name.length(), SQLITE_STATIC);
+            exists = sqlite3_step(stmt) == SQLITE_ROW;
+            sqlite3_finalize(stmt);
+            return exists;
+        }
+
+        sqlite3 *database;
+        bool ownsDatabase;
+        bool finished;
+        int startResult;
+        std::vector<std::pair<std::string, std::string>> pragmas; // Name and value to restore, in the order they were set.
+        std::vector<std::pair<std::string, std::string>> indexes; // Name (empty if added with createIndex()) and SQL.
+    };
+
     /**
      * Explicitly set the path to the SQLite database file on runtime instead of using the one defined on compile time with the macros
      * SQLT_DATABASE, SQLT_DATABASE_WITH_NAME and SQLT_DATABASE_WITH_NAME_AND_PATH.
@@ -2322,6 +5681,435 @@ namespace SQLT
 }
 // END SQLT NAMESPACE
 
+// Note: SQLite must be built thread safe (the default) when using SQLITE_TOOLS_USE_ASYNC_WRITER
+#if defined(SQLITE_TOOLS_USE_ASYNC_WRITER)
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+
+namespace SQLT
+{
+    namespace Internal
+    {
+        // A row waiting in the AsyncWriter queue. The base class is used as the stub node of the queue.
+        struct AsyncWriteNode
+        {
+            AsyncWriteNode()
+                : next(nullptr)
+            {}
+
+            virtual ~AsyncWriteNode() {}
+            virtual int write(StatementCache&) { return SQLITE_OK; }
+            virtual void complete(int) {}
+
+            std::atomic<AsyncWriteNode*> next;
+        };
+
+        template<typename SQLT_TABLE>
+        struct AsyncWriteRow : public AsyncWriteNode
+        {
+            AsyncWriteRow(SQLT_TABLE&& row, std::function<void(int)>&& callback)
+                : row(std::move(row))
+                , callback(std::move(callback))
+            {}
+
+            int write(StatementCache& cache) override
+            {
+                return SQLT::insert(cache, row);
+            }
+
+            void complete(int result) override
+            {
+                if (callback)
+                    callback(result);
+                else
+                    promise.set_value(result);
+            }
+
+            SQLT_TABLE row;
+            std::function<void(int)> callback;
+            std::promise<int> promise;
+        };
+
+        // Intrusive multi-producer single-consumer queue (Dmitry Vyukov). push() is wait-free and may be called from any
+        // thread, pop() must only be called from the consumer thread. pop() can return nullptr while a push is in progress.
+        class AsyncWriteQueue
+        {
+        public:
+            AsyncWriteQueue()
+                : head(&stub)
+                , tail(&stub)
+            {}
+
+            AsyncWriteQueue(const AsyncWriteQueue&) = delete;
+            AsyncWriteQueue& operator=(const AsyncWriteQueue&) = delete;
+
+            void push(AsyncWriteNode *node)
+            {
+                node->next.store(nullptr, std::memory_order_relaxed);
+                AsyncWriteNode *previous = head.exchange(node, std::memory_order_acq_rel);
+                previous->next.store(node, std::memory_order_release);
+            }
+
+            AsyncWriteNode *pop()
+            {
+                AsyncWriteNode *first = tail;
+                AsyncWriteNode *next = first->next.load(std::memory_order_acquire);
+                if (first == &stub)
+                {
+                    if (!next)
+                        return nullptr;
+                    tail = next;
+                    first = next;
+                    next = next->next.load(std::memory_order_acquire);
+                }
+
+                if (next)
+                {
+                    tail = next;
+                    return first;
+                }
+
+                if (first != head.load(std::memory_order_acquire))
+                    return nullptr;
+
+                push(&stub);
+                next = first->next.load(std::memory_order_acquire);
+                if (next)
+                {
+                    tail = next;
+                    return first;
+                }
+                return nullptr;
+            }
+
+        private:
+            AsyncWriteNode stub;
+            std::atomic<AsyncWriteNode*> head;
+            AsyncWriteNode *tail;
+        };
+    }
+
+    /**
+     * Configuration of an SQLT::AsyncWriter.
+     */
+    struct AsyncWriterOptions
+    {
+        AsyncWriterOptions()
+            : maxBatchRows(1000)
+            , flushInterval(10)
+            , busyTimeout(5000)
+        {}
+
+        size_t maxBatchRows;                     // The maximum number of rows written in one transaction.
+        std::chrono::milliseconds flushInterval; // The longest time a partial batch waits for more rows before it is written.
+        int busyTimeout;                         // The sqlite3_busy_timeout() of the writer connection in milliseconds.
+    };
+
+    /**
+     * Callback for rows pushed to an SQLT::AsyncWriter. Called on the writer thread with the SQLite error code of the row
+     * once the transaction of its batch has finished. Will be SQLITE_OK if the row was committed.
+     */
+    typedef std::function<void(int result)> AsyncWriteCallback;
+
+    /**
+     * Writes rows to a database on a background thread. The writer owns its own connection to the database and a worker
+     * thread. Rows of any table in the database can be pushed from any number of threads through a lock-free queue. The
+     * worker drains the queue in batches of up to AsyncWriterOptions::maxBatchRows rows and writes each batch in a single
+     * transaction, so the producers never wait for the disk.
+     *
+     * A row that fails (e.g. on a constraint) only fails itself, the other rows of its batch are still committed. If the
+     * transaction itself fails, all rows of the batch fail with its error code.
+     *
+     * Requires SQLITE_TOOLS_USE_ASYNC_WRITER to be defined before sqlite_tools.h is included.
+     *
+     * @tparam SQLT_DB The database to write to, defined by SQLT_DATABASE, SQLT_DATABASE_WITH_NAME or SQLT_DATABASE_WITH_NAME_AND_PATH.
+     */
+    template<typename SQLT_DB>
+    class AsyncWriter
+    {
+    public:
+        /**
+         * Open the database and start the worker thread.
+         *
+         * @param options The batching configuration.
+         */
+        explicit AsyncWriter(const AsyncWriterOptions& options = AsyncWriterOptions())
+            : options(options)
+            , db(nullptr)
+            , openResult(SQLITE_OK)
+            , stopping(false)
+            , flushWaiters(0)
+            , pushedCount(0)
+            , completedCount(0)
+            , committedRowCount(0)
+            , committedBatchCount(0)
+            , lastLatency(0)
+            , maxLatency(0)
+            , totalLatency(0)
+        {
+            if (this->options.maxBatchRows == 0)
+                this->options.maxBatchRows = 1;
+
+            openResult = SQLT::open<SQLT_DB>(&db);
+            if (openResult == SQLITE_OK)
+                sqlite3_busy_timeout(db, this->options.busyTimeout);
+            else
+                db = nullptr;
+
+            worker = std::thread(&AsyncWriter::run, this);
+        }
+
+        /**
+         * Write all rows in the queue, stop the worker thread and close the connection.
+         */
+        ~AsyncWriter()
+        {
+            {
+                std::lock_guard<std::mutex> lock(wakeMutex);
+                stopping.store(true);
+            }
+            wakeCondition.notify_one();
+            worker.join();
+
+            if (db)
+                SQLT::close<SQLT_DB>(db);
+        }
+
+        AsyncWriter(const AsyncWriter&) = delete;
+        AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+        /**
+         * @return The result of opening the database. Rows pushed to a writer that failed to open fail with this error code.
+         */
+        int status() const { return openResult; }
+
+        /**
+         * Queue a row for insertion.
+         *
+         * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+         * @param row The row to insert into the database.
+         * @return A future with the SQLite error code of the row. Will be SQLITE_OK once the row is committed.
+         */
+        template<typename SQLT_TABLE>
+        std::future<int> push(SQLT_TABLE row)
+        {
+            SQLT::Internal::AsyncWriteRow<SQLT_TABLE> *node = new SQLT::Internal::AsyncWriteRow<SQLT_TABLE>(std::move(row), AsyncWriteCallback());
+            std::future<int> future = node->promise.get_future();
+            enqueue(node);
+            return future;
+        }
+
+        /**
+         * Queue a row for insertion.
+         *
+         * @tparam SQLT_TABLE An SQLT table struct defined by SQLT_TABLE or SQLT_TABLE_WITH_NAME.
+         * @param row The row to insert into the database.
+         * @param callback Called on the writer thread with the SQLite error code of the row when its batch has finished.
+         */
+        template<typename SQLT_TABLE>
+        void push(SQLT_TABLE row, AsyncWriteCallback callback)
+        {
+            enqueue(new SQLT::Internal::AsyncWriteRow<SQLT_TABLE>(std::move(row), std::move(callback)));
+        }
+
+        /**
+         * Write the queued rows without waiting for the flush interval and block until they have finished. All rows pushed
+         * by the calling thread before the call have finished when flush() returns.
+         */
+        void flush()
+        {
+            const uint64_t target = pushedCount.load();
+            flushWaiters++;
+            {
+                std::lock_guard<std::mutex> lock(wakeMutex);
+            }
+            wakeCondition.notify_one();
+
+            std::unique_lock<std::mutex> lock(flushMutex);
+            flushCondition.wait(lock, [this, target]() { return completedCount.load() >= target; });
+            flushWaiters--;
+        }
+
+        /**
+         * @return The number of rows pushed that have not finished yet.
+         */
+        size_t queueDepth() const { return (size_t)(pushedCount.load() - completedCount.load()); }
+
+        /**
+         * @return The number of rows that have been committed.
+         */
+        uint64_t committedRows() const { return committedRowCount.load(); }
+
+        /**
+         * @return The number of batches that have been committed.
+         */
+        uint64_t committedBatches() const { return committedBatchCount.load(); }
+
+        /**
+         * @return The time from "BEGIN" to "COMMIT" of the last committed batch.
+         */
+        std::chrono::microseconds lastCommitLatency() const { return std::chrono::microseconds(lastLatency.load()); }
+
+        /**
+         * @return The longest time from "BEGIN" to "COMMIT" of a committed batch.
+         */
+        std::chrono::microseconds maxCommitLatency() const { return std::chrono::microseconds(maxLatency.load()); }
+
+        /**
+         * @return The average time from "BEGIN" to "COMMIT" of the committed batches.
+         */
+        std::chrono::microseconds averageCommitLatency() const
+        {
+            const uint64_t batches = committedBatchCount.load();
+            return std::chrono::microseconds(batches ? totalLatency.load() / (int64_t)batches : 0);
+        }
+
+    private:
+        void enqueue(SQLT::Internal::AsyncWriteNode *node)
+        {
+            pushedCount++;
+            queue.push(node);
+
+            // Wake the worker on the first row and when there is a full batch. Not done under the mutex, so a wake up
+            // may be missed and the rows are then picked up at the end of the flush interval.
+            const size_t depth = queueDepth();
+            if (depth == 1 || depth >= options.maxBatchRows)
+                wakeCondition.notify_one();
+        }
+
+        void popBatch(std::vector<SQLT::Internal::AsyncWriteNode*>& batch)
+        {
+            SQLT::Internal::AsyncWriteNode *node;
+            while (batch.size() < options.maxBatchRows && (node = queue.pop()) != nullptr)
+                batch.push_back(node);
+        }
+
+        void run()
+        {
+            std::vector<SQLT::Internal::AsyncWriteNode*> batch;
+            std::vector<int> results;
+            batch.reserve(options.maxBatchRows);
+            results.reserve(options.maxBatchRows);
+
+            StatementCache cache(db);
+            while (true)
+            {
+                popBatch(batch);
+                if (batch.size() < options.maxBatchRows && !stopping.load())
+                {
+                    std::unique_lock<std::mutex> lock(wakeMutex);
+                    if (batch.empty())
+                    {
+                        // Idle, wait for the first row.
+                        wakeCondition.wait_for(lock, options.flushInterval, [this]() {
+                            return stopping.load() || queueDepth() != 0;
+                        });
+                    }
+                    else if (flushWaiters.load() == 0)
+                    {
+                        // Give the producers the flush interval to fill up the batch.
+                        wakeCondition.wait_for(lock, options.flushInterval, [this]() {
+                            return stopping.load() || flushWaiters.load() != 0 || queueDepth() >= options.maxBatchRows;
+                        });
+                    }
+                    lock.unlock();
+                    popBatch(batch);
+                }
+
+                if (batch.empty())
+                {
+                    if (stopping.load() && queueDepth() == 0)
+                        break;
+                    continue;
+                }
+
+                writeBatch(cache, batch, results);
+                batch.clear();
+            }
+        }
+
+        void writeBatch(StatementCache& cache, const std::vector<SQLT::Internal::AsyncWriteNode*>& batch, std::vector<int>& results)
+        {
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            results.assign(batch.size(), SQLITE_OK);
+
+            int result = openResult;
+            if (result == SQLITE_OK)
+                result = sqlite3_exec(db, "BEGIN IMMEDIATE", NULL, NULL, NULL);
+
+            if (result == SQLITE_OK)
+            {
+                for (size_t i = 0; i < batch.size(); i++)
+                {
+                    results[i] = batch[i]->write(cache);
+
+                    // Some errors roll back the whole transaction, and with it the rows written before this one.
+                    if (results[i] != SQLITE_OK && sqlite3_get_autocommit(db))
+                    {
+                        result = results[i];
+                        break;
+                    }
+                }
+
+                if (result == SQLITE_OK)
+                    result = sqlite3_exec(db, "COMMIT", NULL, NULL, NULL);
+
+                if (result != SQLITE_OK && !sqlite3_get_autocommit(db))
+                    sqlite3_exec(db, "ROLLBACK", NULL, NULL, NULL);
+            }
+
+            if (result == SQLITE_OK)
+            {
+                const int64_t latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+                lastLatency.store(latency);
+                if (latency > maxLatency.load())
+                    maxLatency.store(latency);
+                totalLatency += latency;
+                committedBatchCount++;
+                committedRowCount += (uint64_t)std::count(results.begin(), results.end(), SQLITE_OK);
+            }
+
+            for (size_t i = 0; i < batch.size(); i++)
+            {
+                batch[i]->complete(result == SQLITE_OK ? results[i] : result);
+                delete batch[i];
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(flushMutex);
+                completedCount += batch.size();
+            }
+            flushCondition.notify_all();
+        }
+
+        AsyncWriterOptions options;
+        sqlite3 *db;
+        int openResult;
+        SQLT::Internal::AsyncWriteQueue queue;
+        std::thread worker;
+
+        std::mutex wakeMutex;
+        std::condition_variable wakeCondition;
+        std::mutex flushMutex;
+        std::condition_variable flushCondition;
+        std::atomic<bool> stopping;
+        std::atomic<int> flushWaiters;
+
+        std::atomic<uint64_t> pushedCount;
+        std::atomic<uint64_t> completedCount;
+        std::atomic<uint64_t> committedRowCount;
+        std::atomic<uint64_t> committedBatchCount;
+        std::atomic<int64_t> lastLatency;
+        std::atomic<int64_t> maxLatency;
+        std::atomic<int64_t> totalLatency;
+    };
+}
+#endif
+
 // Note: json_struct.h must be included elsewhere in the application when using SQLITE_TOOLS_USE_JSON_STRUCT
 #if defined(SQLITE_TOOLS_USE_JSON_STRUCT)
 namespace JS
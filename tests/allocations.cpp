@@ -0,0 +1,315 @@
+#include "assert.h"
+
+#include <sqlite3/sqlite3.h>
+#include <sqlite_tools.h>
+
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+// Counts every allocation made through the global operator new. SQLite allocates through malloc and is not counted.
+static size_t allocationCount = 0;
+
+void *operator new(std::size_t size)
+{
+    allocationCount++;
+    void *p = std::malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+// The replaced operator new allocates with malloc, so freeing in operator delete is matched.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+struct alloc_db
+{
+    struct Event
+    {
+        int id;
+        std::string source;
+        std::string message;
+        std::string category;
+        SQLT::Nullable<double> duration;
+        bool handled;
+
+        SQLT_TABLE(Event,
+            SQLT_COLUMN_PRIMARY_KEY(id),
+            SQLT_COLUMN(source),
+            SQLT_COLUMN(message),
+            SQLT_COLUMN_DEFAULT(category, "a default category that does not fit in the small string buffer"),
+            SQLT_COLUMN(duration),
+            SQLT_COLUMN(handled)
+        );
+    };
+
+    SQLT_DATABASE_WITH_NAME(alloc_db, "alloc_db.sqlite",
+        SQLT_DATABASE_TABLE(Event)
+    );
+
+    struct EventSummary
+    {
+        int id;
+        std::string category;
+        bool handled;
+
+        SQLT_QUERY_RESULT_STRUCT(EventSummary,
+            SQLT_QUERY_RESULT_MEMBER(id),
+            SQLT_QUERY_RESULT_MEMBER(category),
+            SQLT_QUERY_RESULT_MEMBER(handled)
+        );
+    };
+};
+
+void testSingleRowInsert()
+{
+    char *errMsg;
+    int result;
+    sqlite3 *db;
+
+    result = SQLT::dropAllTables<alloc_db>(&errMsg);        SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::open<alloc_db>(&db);                     SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::createAllTables<alloc_db>(db, &errMsg);  SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::begin<alloc_db>(db);                     SQLT_ASSERT(result == SQLITE_OK);
+
+    alloc_db::Event event = { 0, "a source name that does not fit in the small string buffer",
+                              "a message that does not fit in the small string buffer either", "event", { 1.5 }, false };
+    {
+        SQLT::StatementCache cache(db);
+
+        // The first insert prepares and caches the statement.
+        result = SQLT::insert(cache, event);                SQLT_ASSERT(result == SQLITE_OK);
+
+        size_t before = allocationCount;
+        for (int i = 1; i <= 1000; i++)
+        {
+            event.id = i;
+            event.handled = (i % 2) == 0;
+            event.duration.is_null = (i % 3) == 0;
+            result = SQLT::insert(cache, event);
+            SQLT_ASSERT(result == SQLITE_OK);
+        }
+        SQLT_ASSERT(allocationCount == before);
+    }
+
+    result = SQLT::commit<alloc_db>(db);                    SQLT_ASSERT(result == SQLITE_OK);
+
+    std::vector<alloc_db::Event> events;
+    result = SQLT::selectAll(db, &events);                  SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(events.size() == 1001);
+    SQLT_ASSERT(events[1000].id == 1000 && events[1000].handled && events[1000].message == event.message);
+    SQLT_ASSERT(events[999].duration.is_null && !events[998].duration.is_null);
+
+    // The uncached single row insert does not copy the row into a vector, and its SQL is built only once.
+    event.id = 1001;
+    result = SQLT::insert(db, event);                       SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::deleteAll<alloc_db::Event>(db);          SQLT_ASSERT(result == SQLITE_OK);
+    size_t before = allocationCount;
+    event.id = 1002;
+    result = SQLT::insert(db, event);                       SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::deleteAll<alloc_db::Event>(db);          SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::createTableIfNotExists<alloc_db::Event>(db, &errMsg);
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(allocationCount == before);
+
+    result = SQLT::close<alloc_db>(db);                     SQLT_ASSERT(result == SQLITE_OK);
+}
+
+// Strings short enough for the small string buffer need no heap allocation, so any allocation counted while inserting
+// or selecting these rows is made per row by the library itself, e.g. by copying the column info of a table.
+void testRowDecode()
+{
+    static const int COUNT = 1000;
+    static const size_t MAX_ALLOCATIONS_PER_CALL = 4;
+
+    char *errMsg;
+    int result;
+    sqlite3 *db;
+
+    result = SQLT::dropAllTables<alloc_db>(&errMsg);        SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::open<alloc_db>(&db);                     SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::createAllTables<alloc_db>(db, &errMsg);  SQLT_ASSERT(result == SQLITE_OK);
+
+    std::vector<alloc_db::Event> events;
+    events.reserve(COUNT);
+    for (int i = 0; i < COUNT; i++)
+        events.push_back({ i, "src", "msg", "cat", { /*NULL*/ }, i % 2 == 0 });
+
+    // Warm up the function-local statics of the SQL strings.
+    std::vector<alloc_db::Event> selected;
+    std::vector<alloc_db::EventSummary> summaries;
+    result = SQLT::insert(db, std::vector<alloc_db::Event>(events.begin(), events.begin() + 1));
+    SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::selectAll(db, &selected);                SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::deleteAll<alloc_db::Event>(db);          SQLT_ASSERT(result == SQLITE_OK);
+    selected.clear();
+
+    // 1. Insert.
+    size_t before = allocationCount;
+    result = SQLT::insert(db, events);                      SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(allocationCount - before <= MAX_ALLOCATIONS_PER_CALL);
+
+    // 2. selectAll, into a vector with room for the rows.
+    selected.reserve(COUNT);
+    before = allocationCount;
+    result = SQLT::selectAll(db, &selected, COUNT);         SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(allocationCount - before <= MAX_ALLOCATIONS_PER_CALL);
+    SQLT_ASSERT(selected.size() == COUNT && selected[7].id == 7 && selected[7].category == "cat");
+
+    // 3. Custom select.
+    summaries.reserve(COUNT);
+    before = allocationCount;
+    result = SQLT::select(db, "SELECT id, category, handled FROM Event;", &summaries, COUNT);
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(allocationCount - before <= MAX_ALLOCATIONS_PER_CALL);
+    SQLT_ASSERT(summaries.size() == COUNT && summaries[8].handled && !summaries[9].handled);
+
+    result = SQLT::close<alloc_db>(db);                     SQLT_ASSERT(result == SQLITE_OK);
+}
+
+// Streaming the rows decodes them all into the same struct, so the allocations do not depend on the row count.
+void testForEach()
+{
+    static const size_t MAX_ALLOCATIONS_PER_CALL = 4;
+
+    int result;
+    sqlite3 *db;
+    result = SQLT::open<alloc_db>(&db);                     SQLT_ASSERT(result == SQLITE_OK);
+
+    // 1. All rows of the table inserted by testRowDecode().
+    int rowCount = 0;
+    long long idSum = 0;
+    size_t before = allocationCount;
+    result = SQLT::forEachAll<alloc_db::Event>(db, [&](const alloc_db::Event& event)
+    {
+        rowCount++;
+        idSum += event.id;
+        return true;
+    });
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(allocationCount - before <= MAX_ALLOCATIONS_PER_CALL);
+    SQLT_ASSERT(rowCount == 1000 && idSum == 999 * 1000 / 2);
+
+    // 2. A custom query with parameters, stopped early.
+    rowCount = 0;
+    before = allocationCount;
+    result = SQLT::forEach<alloc_db::EventSummary>(db, "SELECT id, category, handled FROM Event WHERE id >= ? ORDER BY id;", SQLT::params(500),
+                                                   [&](const alloc_db::EventSummary& summary)
+    {
+        SQLT_ASSERT(summary.id == 500 + rowCount && summary.category == "cat");
+        return ++rowCount < 10;
+    });
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(allocationCount - before <= MAX_ALLOCATIONS_PER_CALL);
+    SQLT_ASSERT(rowCount == 10);
+
+    // 3. Long strings decoded into the reused struct keep its capacity.
+    rowCount = 0;
+    before = allocationCount;
+    result = SQLT::forEach<alloc_db::EventSummary>(db, "SELECT id, printf('%050d', id) AS category, handled FROM Event;",
+                                                   [&](const alloc_db::EventSummary& summary)
+    {
+        SQLT_ASSERT(summary.category.size() == 50 && std::stoi(summary.category) == summary.id);
+        rowCount++;
+        return true;
+    });
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(allocationCount - before <= MAX_ALLOCATIONS_PER_CALL);
+    SQLT_ASSERT(rowCount == 1000);
+
+    // 4. Errors are returned as for select.
+    result = SQLT::forEach<alloc_db::EventSummary>(db, "SELECT id FROM NoSuchTable;", [](const alloc_db::EventSummary&) { return true; });
+    SQLT_ASSERT(result == SQLITE_ERROR);
+
+    result = SQLT::close<alloc_db>(db);                     SQLT_ASSERT(result == SQLITE_OK);
+}
+
+// Polling a table into the same vector overwrites its rows in place, so unchanged rows cost no allocations.
+void testSelectInto()
+{
+    static const int COUNT = 100;
+    static const size_t MAX_ALLOCATIONS_PER_CALL = 4;
+
+    char *errMsg;
+    int result;
+    sqlite3 *db;
+
+    result = SQLT::dropAllTables<alloc_db>(&errMsg);        SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::open<alloc_db>(&db);                     SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::createAllTables<alloc_db>(db, &errMsg);  SQLT_ASSERT(result == SQLITE_OK);
+
+    std::vector<alloc_db::Event> events;
+    for (int i = 0; i < COUNT; i++)
+        events.push_back({ i, "a source that does not fit in the small string buffer", "message " + std::string(40, 'm'), "category", { /*NULL*/ }, false });
+    result = SQLT::insert(db, events);                      SQLT_ASSERT(result == SQLITE_OK);
+
+    // 1. The first select appends every row.
+    std::vector<alloc_db::Event> polled;
+    size_t changed = 0;
+    result = SQLT::selectInto(db, &polled, &changed);       SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(changed == COUNT && polled.size() == COUNT);
+    SQLT_ASSERT(polled[5].source == events[5].source);
+
+    // 2. Unchanged rows are left as they are.
+    size_t before = allocationCount;
+    result = SQLT::selectInto(db, &polled, &changed);       SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(allocationCount - before <= MAX_ALLOCATIONS_PER_CALL);
+    SQLT_ASSERT(changed == 0 && polled.size() == COUNT);
+
+    // 3. Changed rows are overwritten in place.
+    const std::string message = "changed " + std::string(40, 'c');
+    result = SQLT::query(db, "UPDATE Event SET message = ?, duration = 1.5 WHERE id % 20 = 0;", message);
+    SQLT_ASSERT(result == SQLITE_OK);
+    before = allocationCount;
+    result = SQLT::selectInto(db, &polled, &changed);       SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(allocationCount - before <= MAX_ALLOCATIONS_PER_CALL);
+    SQLT_ASSERT(changed == COUNT / 20);
+    SQLT_ASSERT(polled[40].message == message && !polled[40].duration.is_null && polled[41].message == events[41].message);
+
+    // 4. Rows are erased and appended at the end.
+    result = SQLT::query(db, "DELETE FROM Event WHERE id >= ?;", COUNT - 10);
+    SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::selectInto(db, &polled, &changed);       SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(changed == 10 && polled.size() == COUNT - 10);
+
+    result = SQLT::insert(db, std::vector<alloc_db::Event>(events.end() - 2, events.end()));
+    SQLT_ASSERT(result == SQLITE_OK);
+    {
+        SQLT::StatementCache cache(db);
+        result = SQLT::selectInto(cache, &polled, &changed); SQLT_ASSERT(result == SQLITE_OK);
+        SQLT_ASSERT(changed == 2 && polled.size() == COUNT - 8);
+        SQLT_ASSERT(polled.back().id == COUNT - 1);
+
+        result = SQLT::selectInto(cache, &polled);           SQLT_ASSERT(result == SQLITE_OK);
+        SQLT_ASSERT(polled.size() == COUNT - 8);
+    }
+
+    result = SQLT::close<alloc_db>(db);                     SQLT_ASSERT(result == SQLITE_OK);
+}
+
+int main()
+{
+    testSingleRowInsert();
+    testRowDecode();
+    testForEach();
+    testSelectInto();
+    return 0;
+}
@@ -0,0 +1,139 @@
+#include "assert.h"
+
+#include <sqlite3/sqlite3.h>
+#define SQLITE_TOOLS_USE_ASYNC_WRITER
+#include <sqlite_tools.h>
+
+#include <atomic>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct async_db
+{
+    struct Event
+    {
+        int id;
+        std::string source;
+        double value;
+
+        SQLT_TABLE(Event,
+            SQLT_COLUMN_PRIMARY_KEY(id),
+            SQLT_COLUMN(source),
+            SQLT_COLUMN(value)
+        );
+    };
+
+    struct Note
+    {
+        int id;
+        std::string text;
+
+        SQLT_TABLE(Note,
+            SQLT_COLUMN_PRIMARY_KEY(id),
+            SQLT_COLUMN(text)
+        );
+    };
+
+    SQLT_DATABASE_WITH_NAME(async_db, "async_db.sqlite",
+        SQLT_DATABASE_TABLE(Event),
+        SQLT_DATABASE_TABLE(Note)
+    );
+
+    struct RowCount
+    {
+        int count;
+
+        SQLT_QUERY_RESULT_STRUCT(RowCount,
+            SQLT_QUERY_RESULT_MEMBER(count)
+        );
+    };
+};
+
+int rowCount(const std::string& table)
+{
+    std::vector<async_db::RowCount> count;
+    int result = SQLT::select<async_db>("SELECT COUNT(*) AS count FROM " + table + ";", &count, 1);
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(count.size() == 1);
+    return count[0].count;
+}
+
+int main()
+{
+    char *errMsg;
+    int result;
+
+    result = SQLT::dropAllTables<async_db>(&errMsg);        SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::createAllTables<async_db>(&errMsg);      SQLT_ASSERT(result == SQLITE_OK);
+
+    const int producers = 4;
+    const int rowsPerProducer = 2500;
+    std::atomic<int> callbackErrors(0);
+    std::atomic<int> callbacks(0);
+    std::vector<std::future<int>> futures;
+
+    {
+        SQLT::AsyncWriterOptions options;
+        options.maxBatchRows = 500;
+        options.flushInterval = std::chrono::milliseconds(5);
+        SQLT::AsyncWriter<async_db> writer(options);
+        SQLT_ASSERT(writer.status() == SQLITE_OK);
+
+        // 1. Several producers push rows to two tables, with callbacks.
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; p++)
+        {
+            threads.push_back(std::thread([&writer, &callbacks, &callbackErrors, p, rowsPerProducer]() {
+                for (int i = 0; i < rowsPerProducer; i++)
+                {
+                    const int id = p * rowsPerProducer + i;
+                    writer.push(async_db::Event{ id, "producer" + std::to_string(p), i * 0.5 }, [&callbacks, &callbackErrors](int result) {
+                        callbacks++;
+                        if (result != SQLITE_OK)
+                            callbackErrors++;
+                    });
+                    if (i % 100 == 0)
+                        writer.push(async_db::Note{ id, "note" }, [&callbacks](int) { callbacks++; });
+                }
+            }));
+        }
+        for (auto& t : threads)
+            t.join();
+
+        writer.flush();
+        SQLT_ASSERT(writer.queueDepth() == 0);
+        SQLT_ASSERT(callbacks == producers * rowsPerProducer + producers * rowsPerProducer / 100);
+        SQLT_ASSERT(callbackErrors == 0);
+        SQLT_ASSERT(writer.committedRows() == (uint64_t)callbacks.load());
+
+        // Rows are grouped into batches.
+        SQLT_ASSERT(writer.committedBatches() > 0);
+        SQLT_ASSERT(writer.committedBatches() < writer.committedRows());
+        SQLT_ASSERT(writer.maxCommitLatency() >= writer.averageCommitLatency());
+        SQLT_ASSERT(writer.averageCommitLatency().count() > 0);
+
+        // 2. Futures, a failing row fails alone.
+        futures.push_back(writer.push(async_db::Event{ 100000, "future", 1.0 }));
+        futures.push_back(writer.push(async_db::Event{ 0, "duplicate", 1.0 }));
+        futures.push_back(writer.push(async_db::Event{ 100001, "future", 1.0 }));
+        SQLT_ASSERT(futures[0].get() == SQLITE_OK);
+        SQLT_ASSERT(futures[1].get() == SQLITE_CONSTRAINT);
+        SQLT_ASSERT(futures[2].get() == SQLITE_OK);
+
+        // 3. Rows still in the queue are written when the writer is destroyed.
+        for (int i = 0; i < 100; i++)
+            writer.push(async_db::Note{ 100000 + i, "last" }, [&callbacks](int) { callbacks++; });
+    }
+
+    SQLT_ASSERT(rowCount("Event") == producers * rowsPerProducer + 2);
+    SQLT_ASSERT(rowCount("Note") == producers * rowsPerProducer / 100 + 100);
+
+    std::vector<async_db::Event> events;
+    result = SQLT::selectAll<async_db>(&events);            SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(events[2600].id == 2600 && events[2600].source == "producer1");
+    SQLT_FUZZY_ASSERT(events[2600].value, 50.0);
+
+    return 0;
+}
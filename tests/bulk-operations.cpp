@@ -0,0 +1,884 @@
+#include "assert.h"
+
+#include <sqlite3/sqlite3.h>
+#include <sqlite_tools.h>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include <string>
+
+struct bulk_db
+{
+    struct Measurement
+    {
+        int id;
+        std::string sensor;
+        double value;
+
+        SQLT_TABLE(Measurement,
+            SQLT_COLUMN_PRIMARY_KEY(id),
+            SQLT_COLUMN(sensor),
+            SQLT_COLUMN(value)
+        );
+    };
+
+    struct Annotation
+    {
+        int measurement_id;
+        std::string text;
+        std::string author;
+
+        SQLT_TABLE(Annotation,
+            SQLT_COLUMN_PRIMARY_KEY(measurement_id),
+            SQLT_COLUMN_PRIMARY_KEY(text),
+            SQLT_COLUMN(author)
+        );
+    };
+
+    struct Sensor
+    {
+        int id;
+        std::string name;
+        std::string location;
+        double threshold;
+        bool enabled;
+
+        SQLT_TABLE(Sensor,
+            SQLT_COLUMN_PRIMARY_KEY(id),
+            SQLT_COLUMN(name),
+            SQLT_COLUMN(location),
+            SQLT_COLUMN(threshold),
+            SQLT_COLUMN(enabled)
+        );
+    };
+
+    struct Device
+    {
+        int id;
+        std::string name;
+        std::string location;
+        double threshold;
+        bool enabled;
+        SQLT::Nullable<std::string> note;
+
+        SQLT_TABLE(Device,
+            SQLT_COLUMN_PRIMARY_KEY(id),
+            SQLT_COLUMN(name),
+            SQLT_COLUMN(location),
+            SQLT_COLUMN(threshold),
+            SQLT_COLUMN(enabled),
+            SQLT_COLUMN(note)
+        );
+    };
+
+    struct Reading
+    {
+        int id;
+        std::string label;
+        double value;
+        bool valid;
+        SQLT::Nullable<int> count;
+        SQLT::Nullable<std::string> comment;
+
+        SQLT_TABLE(Reading,
+            SQLT_COLUMN_PRIMARY_KEY(id),
+            SQLT_COLUMN(label),
+            SQLT_COLUMN(value),
+            SQLT_COLUMN(valid),
+            SQLT_COLUMN(count),
+            SQLT_COLUMN(comment)
+        );
+    };
+
+    SQLT_DATABASE_WITH_NAME(bulk_db, "bulk_db.sqlite",
+        SQLT_DATABASE_TABLE(Measurement),
+        SQLT_DATABASE_TABLE(Annotation),
+        SQLT_DATABASE_TABLE(Sensor),
+        SQLT_DATABASE_TABLE(Device),
+        SQLT_DATABASE_TABLE(Reading)
+    );
+
+    struct RowCount
+    {
+        int count;
+
+        SQLT_QUERY_RESULT_STRUCT(RowCount,
+            SQLT_QUERY_RESULT_MEMBER(count)
+        );
+    };
+};
+
+int rowCount(sqlite3 *db, const std::string& table)
+{
+    std::vector<bulk_db::RowCount> count;
+    int result = SQLT::select(db, "SELECT COUNT(*) AS count FROM " + table + ";", &count, 1);
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(count.size() == 1);
+    return count[0].count;
+}
+
+std::vector<bulk_db::Measurement> makeMeasurements(int count, int firstId = 0)
+{
+    std::vector<bulk_db::Measurement> measurements;
+    for (int i = 0; i < count; i++)
+        measurements.push_back({ firstId + i, "sensor" + std::to_string(i % 7), i * 0.25 });
+    return measurements;
+}
+
+std::string pragmaValue(sqlite3 *db, const std::string& pragma)
+{
+    sqlite3_stmt *stmt;
+    int result = sqlite3_prepare_v2(db, ("PRAGMA " + pragma + ";").c_str(), -1, &stmt, NULL);
+    SQLT_ASSERT(result == SQLITE_OK);
+    result = sqlite3_step(stmt);
+    SQLT_ASSERT(result == SQLITE_ROW);
+    std::string value = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+    sqlite3_finalize(stmt);
+    return value;
+}
+
+int indexCount(sqlite3 *db)
+{
+    std::vector<bulk_db::RowCount> count;
+    int result = SQLT::select(db, "SELECT COUNT(*) AS count FROM sqlite_master WHERE type = 'index' AND sql IS NOT NULL;", &count, 1);
+    SQLT_ASSERT(result == SQLITE_OK);
+    return count[0].count;
+}
+
+void testBulkInsert()
+{
+    char *errMsg;
+    int result;
+    sqlite3 *db;
+
+    result = SQLT::dropAllTables<bulk_db>(&errMsg);        SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::createAllTables<bulk_db>(&errMsg);      SQLT_ASSERT(result == SQLITE_OK);
+
+    // 1. All chunks are committed and progress is reported after each one.
+    std::vector<bulk_db::Measurement> measurements = makeMeasurements(2500);
+    std::vector<size_t> progress;
+    size_t committed = 0;
+    result = SQLT::bulkInsert<bulk_db>(measurements, 1000, &committed, [&progress](size_t committedRows, size_t totalRows) {
+        SQLT_ASSERT(totalRows == 2500);
+        progress.push_back(committedRows);
+    });
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(committed == 2500);
+    SQLT_ASSERT(progress.size() == 3);
+    SQLT_ASSERT(progress[0] == 1000 && progress[1] == 2000 && progress[2] == 2500);
+
+    result = SQLT::open<bulk_db>(&db);                     SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(rowCount(db, "Measurement") == 2500);
+
+    // 2. A failing chunk is rolled back while the chunks before it stay committed.
+    result = SQLT::deleteAll<bulk_db::Measurement>(db);    SQLT_ASSERT(result == SQLITE_OK);
+    measurements[2100].id = measurements[2050].id;
+    result = SQLT::bulkInsert(db, measurements, 1000, &committed);
+    SQLT_ASSERT(result == SQLITE_CONSTRAINT);
+    SQLT_ASSERT(committed == 2000);
+    SQLT_ASSERT(rowCount(db, "Measurement") == 2000);
+    SQLT_ASSERT(sqlite3_get_autocommit(db) != 0);
+
+    result = SQLT::close<bulk_db>(db);                     SQLT_ASSERT(result == SQLITE_OK);
+}
+
+void testUpsert()
+{
+    char *errMsg;
+    int result;
+    sqlite3 *db;
+
+    result = SQLT::dropAllTables<bulk_db>(&errMsg);        SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::open<bulk_db>(&db);                     SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::createAllTables<bulk_db>(db, &errMsg);  SQLT_ASSERT(result == SQLITE_OK);
+
+    std::vector<bulk_db::Measurement> measurements = makeMeasurements(10);
+    result = SQLT::insert(db, measurements);               SQLT_ASSERT(result == SQLITE_OK);
+
+    // Rows 5-9 conflict with existing rows, rows 10-14 are new.
+    std::vector<bulk_db::Measurement> replayed = makeMeasurements(10, 5);
+    for (auto& m : replayed)
+        m.sensor = "replayed";
+
+    // 1. IGNORE keeps the existing rows and inserts the new ones.
+    result = SQLT::upsert(db, replayed, SQLT::ConflictPolicy::IGNORE);
+    SQLT_ASSERT(result == SQLITE_OK);
+    std::vector<bulk_db::Measurement> selected;
+    result = SQLT::selectAll(db, &selected);               SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(selected.size() == 15);
+    SQLT_ASSERT(selected[5].sensor == "sensor5");
+    SQLT_ASSERT(selected[14].sensor == "replayed");
+
+    // 2. UPDATE overwrites the non-primary key columns of the existing rows.
+    for (auto& m : replayed)
+        m.value = -1.0;
+    {
+        SQLT::StatementCache cache(db);
+        result = SQLT::upsert(cache, replayed);            SQLT_ASSERT(result == SQLITE_OK);
+        result = SQLT::upsert(cache, replayed);            SQLT_ASSERT(result == SQLITE_OK);
+        SQLT_ASSERT(cache.misses() == 1 && cache.hits() == 1);
+    }
+    selected.clear();
+    result = SQLT::selectAll(db, &selected);               SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(selected.size() == 15);
+    SQLT_ASSERT(selected[4].sensor == "sensor4");
+    SQLT_FUZZY_ASSERT(selected[4].value, 1.0);
+    SQLT_ASSERT(selected[5].sensor == "replayed");
+    SQLT_FUZZY_ASSERT(selected[5].value, -1.0);
+
+    // 3. REPLACE replaces the existing rows.
+    replayed.resize(1);
+    replayed[0].sensor = "replaced";
+    result = SQLT::upsert(db, replayed, SQLT::ConflictPolicy::REPLACE);
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(rowCount(db, "Measurement") == 15);
+    std::vector<std::string> sensors;
+    result = SQLT::select<bulk_db>(db, &bulk_db::Measurement::sensor, &sensors);
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(sensors[5] == "replaced");
+
+    result = SQLT::close<bulk_db>(db);                     SQLT_ASSERT(result == SQLITE_OK);
+}
+
+void testStreamingInsert()
+{
+    char *errMsg;
+    int result;
+    sqlite3 *db;
+
+    result = SQLT::dropAllTables<bulk_db>(&errMsg);        SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::open<bulk_db>(&db);                     SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::createAllTables<bulk_db>(db, &errMsg);  SQLT_ASSERT(result == SQLITE_OK);
+
+    // 1. Iterator pair over a sub range.
+    std::vector<bulk_db::Measurement> measurements = makeMeasurements(100);
+    result = SQLT::insert(db, measurements.begin(), measurements.begin() + 40);
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(rowCount(db, "Measurement") == 40);
+
+    // 2. Pointers and reference wrappers to rows held elsewhere.
+    std::vector<const bulk_db::Measurement*> pointers;
+    for (size_t i = 40; i < 70; i++)
+        pointers.push_back(&measurements[i]);
+    result = SQLT::insert(db, pointers.begin(), pointers.end());
+    SQLT_ASSERT(result == SQLITE_OK);
+
+    std::vector<std::reference_wrapper<const bulk_db::Measurement>> references;
+    for (size_t i = 70; i < 100; i++)
+        references.push_back(std::cref(measurements[i]));
+    {
+        SQLT::StatementCache cache(db);
+        result = SQLT::insert(cache, references.begin(), references.begin() + 15);
+        SQLT_ASSERT(result == SQLITE_OK);
+        result = SQLT::insert(cache, references.begin() + 15, references.end());
+        SQLT_ASSERT(result == SQLITE_OK);
+        SQLT_ASSERT(cache.misses() == 1 && cache.hits() == 1);
+    }
+    SQLT_ASSERT(rowCount(db, "Measurement") == 100);
+
+    std::vector<bulk_db::Measurement> selected;
+    result = SQLT::selectAll(db, &selected);               SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(selected.size() == 100);
+    SQLT_ASSERT(selected[55].id == 55 && selected[55].sensor == measurements[55].sensor);
+    SQLT_ASSERT(selected[99].id == 99 && selected[99].sensor == measurements[99].sensor);
+
+    // 3. Generator filling a reused row.
+    int next = 100;
+    size_t inserted = 0;
+    result = SQLT::insertFrom<bulk_db::Measurement>(db, [&next](bulk_db::Measurement& row) {
+        if (next == 1100)
+            return false;
+        row.id = next;
+        row.sensor = "generated";
+        row.value = next++ * 0.5;
+        return true;
+    }, &inserted);
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(inserted == 1000);
+    SQLT_ASSERT(rowCount(db, "Measurement") == 1100);
+
+    // 4. A failing generated row stops the insert and reports the rows inserted before it.
+    next = 0;
+    result = SQLT::insertFrom<bulk_db::Measurement>(db, [&next](bulk_db::Measurement& row) {
+        row.id = 2000 + next;
+        if (next == 5)
+            row.id = 2000;
+        row.sensor = "generated";
+        row.value = 0.0;
+        return next++ < 10;
+    }, &inserted);
+    SQLT_ASSERT(result == SQLITE_CONSTRAINT);
+    SQLT_ASSERT(inserted == 5);
+
+    result = SQLT::close<bulk_db>(db);                     SQLT_ASSERT(result == SQLITE_OK);
+}
+
+void testBulkLoadSession()
+{
+    char *errMsg;
+    int result;
+    sqlite3 *db;
+
+    result = SQLT::dropAllTables<bulk_db>(&errMsg);        SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::open<bulk_db>(&db);                     SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::createAllTables<bulk_db>(db, &errMsg);  SQLT_ASSERT(result == SQLITE_OK);
+    result = sqlite3_exec(db, "CREATE INDEX ix_sensor ON Measurement(sensor);", NULL, NULL, NULL);
+    SQLT_ASSERT(result == SQLITE_OK);
+
+    const std::string synchronous = pragmaValue(db, "synchronous");
+    const std::string journalMode = pragmaValue(db, "journal_mode");
+    const std::string cacheSize = pragmaValue(db, "cache_size");
+
+    // 1. A session on an existing connection drops the index and switches the pragmas.
+    {
+        SQLT::BulkLoadSession<bulk_db> session(db, -65536);
+        SQLT_ASSERT(session.status() == SQLITE_OK);
+        SQLT_ASSERT(session.db() == db);
+        SQLT_ASSERT(pragmaValue(db, "synchronous") == "0");
+        SQLT_ASSERT(pragmaValue(db, "journal_mode") == "memory");
+        SQLT_ASSERT(pragmaValue(db, "locking_mode") == "exclusive");
+        SQLT_ASSERT(pragmaValue(db, "cache_size") == "-65536");
+        SQLT_ASSERT(indexCount(db) == 0);
+
+        result = SQLT::bulkInsert(session.db(), makeMeasurements(5000), 0);
+        SQLT_ASSERT(result == SQLITE_OK);
+        session.createIndex("CREATE INDEX ix_value ON Measurement(value);");
+        SQLT_ASSERT(indexCount(db) == 0);
+
+        result = session.finish();                         SQLT_ASSERT(result == SQLITE_OK);
+        result = session.finish();                         SQLT_ASSERT(result == SQLITE_OK);
+    }
+    SQLT_ASSERT(indexCount(db) == 2);
+    SQLT_ASSERT(pragmaValue(db, "synchronous") == synchronous);
+    SQLT_ASSERT(pragmaValue(db, "journal_mode") == journalMode);
+    SQLT_ASSERT(pragmaValue(db, "locking_mode") == "normal");
+    SQLT_ASSERT(pragmaValue(db, "cache_size") == cacheSize);
+
+    // The exclusive lock is released, so other connections can write again.
+    result = SQLT::insert<bulk_db>(bulk_db::Measurement{ 5000, "other", 1.0 });
+    SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::close<bulk_db>(db);                     SQLT_ASSERT(result == SQLITE_OK);
+
+    // 2. A session with its own connection, rebuilding the schema from scratch.
+    {
+        SQLT::BulkLoadSession<bulk_db> session;
+        SQLT_ASSERT(session.status() == SQLITE_OK);
+        result = SQLT::dropAllTables<bulk_db>(session.db(), &errMsg);
+        SQLT_ASSERT(result == SQLITE_OK);
+        result = SQLT::createAllTables<bulk_db>(session.db(), &errMsg);
+        SQLT_ASSERT(result == SQLITE_OK);
+        result = SQLT::bulkInsert(session.db(), makeMeasurements(1000), 0);
+        SQLT_ASSERT(result == SQLITE_OK);
+    }
+
+    result = SQLT::open<bulk_db>(&db);                     SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(rowCount(db, "Measurement") == 1000);
+    SQLT_ASSERT(indexCount(db) == 2);
+    result = SQLT::close<bulk_db>(db);                     SQLT_ASSERT(result == SQLITE_OK);
+}
+
+void testInsertReturningIds()
+{
+    char *errMsg;
+    int result;
+    sqlite3 *db;
+
+    result = SQLT::dropAllTables<bulk_db>(&errMsg);        SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::open<bulk_db>(&db);                     SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::createAllTables<bulk_db>(db, &errMsg);  SQLT_ASSERT(result == SQLITE_OK);
+
+    // 1. The rowids of rows inserted with their own primary keys are the primary keys.
+    std::vector<bulk_db::Measurement> measurements = makeMeasurements(10, 100);
+    std::vector<int64_t> ids;
+    result = SQLT::insertReturningIds(db, measurements, &ids);
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(ids.size() == 10);
+    SQLT_ASSERT(ids[0] == 100 && ids[9] == 109);
+
+    // 2. SQLite assigns the primary keys and the rows can be linked to them.
+    measurements = makeMeasurements(5);
+    ids.clear();
+    result = SQLT::insertReturningIds(db, measurements, &ids, true);
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(ids.size() == 5);
+    SQLT_ASSERT(ids[0] == 110 && ids[4] == 114);
+
+    std::vector<bulk_db::Annotation> annotations;
+    for (size_t i = 0; i < ids.size(); i++)
+        annotations.push_back({ (int)ids[i], measurements[i].sensor, "importer" });
+    result = SQLT::insert(db, annotations);                SQLT_ASSERT(result == SQLITE_OK);
+
+    std::vector<bulk_db::Measurement> selected;
+    result = SQLT::selectAll(db, &selected);               SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(selected.size() == 15);
+    SQLT_ASSERT(selected[12].id == 112 && selected[12].sensor == "sensor2");
+
+    // 3. Ids of the rows before a failing row are still collected.
+    measurements = makeMeasurements(3, 200);
+    measurements[2].id = 100;
+    ids.clear();
+    result = SQLT::insertReturningIds(db, measurements, &ids);
+    SQLT_ASSERT(result == SQLITE_CONSTRAINT);
+    SQLT_ASSERT(ids.size() == 2 && ids[1] == 201);
+
+    // 4. Primary keys can only be assigned for a single int column.
+    ids.clear();
+    result = SQLT::insertReturningIds(db, annotations, &ids, true);
+    SQLT_ASSERT(result == SQLITE_MISUSE);
+    SQLT_ASSERT(ids.empty());
+
+    result = SQLT::close<bulk_db>(db);                     SQLT_ASSERT(result == SQLITE_OK);
+}
+
+void testUpdate()
+{
+    char *errMsg;
+    int result;
+    sqlite3 *db;
+
+    result = SQLT::dropAllTables<bulk_db>(&errMsg);        SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::open<bulk_db>(&db);                     SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::createAllTables<bulk_db>(db, &errMsg);  SQLT_ASSERT(result == SQLITE_OK);
+
+    std::vector<bulk_db::Measurement> measurements = makeMeasurements(100);
+    result = SQLT::insert(db, measurements);               SQLT_ASSERT(result == SQLITE_OK);
+
+    // 1. Rows are updated by primary key, rows that do not exist are not counted.
+    std::vector<bulk_db::Measurement> updated = makeMeasurements(20, 90);
+    for (auto& m : updated)
+    {
+        m.sensor = "updated";
+        m.value = -m.id;
+    }
+    int64_t changes = -1;
+    result = SQLT::update(db, updated, &changes);          SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(changes == 10);
+    SQLT_ASSERT(rowCount(db, "Measurement") == 100);
+
+    std::vector<bulk_db::Measurement> selected;
+    result = SQLT::selectAll(db, &selected);               SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(selected[89].sensor == "sensor5");
+    SQLT_ASSERT(selected[90].sensor == "updated");
+    SQLT_FUZZY_ASSERT(selected[95].value, -95.0);
+
+    // 2. Composite primary keys, through the cache.
+    std::vector<bulk_db::Annotation> annotations({ { 1, "a", "first" }, { 1, "b", "first" }, { 2, "a", "first" } });
+    result = SQLT::insert(db, annotations);                SQLT_ASSERT(result == SQLITE_OK);
+    {
+        SQLT::StatementCache cache(db);
+        std::vector<bulk_db::Annotation> changed({ { 1, "b", "second" } });
+        result = SQLT::update(cache, changed, &changes);   SQLT_ASSERT(result == SQLITE_OK);
+        SQLT_ASSERT(changes == 1);
+        changed[0] = { 2, "a", "third" };
+        result = SQLT::update(cache, changed, &changes);   SQLT_ASSERT(result == SQLITE_OK);
+        SQLT_ASSERT(changes == 1);
+        SQLT_ASSERT(cache.misses() == 1 && cache.hits() == 1);
+    }
+    std::vector<std::string> authors;
+    result = SQLT::select<bulk_db>(db, &bulk_db::Annotation::author, &authors);
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(authors.size() == 3);
+    SQLT_ASSERT(authors[0] == "first" && authors[1] == "second" && authors[2] == "third");
+
+    result = SQLT::close<bulk_db>(db);                     SQLT_ASSERT(result == SQLITE_OK);
+}
+
+void testDeleteByKeys()
+{
+    char *errMsg;
+    int result;
+    sqlite3 *db;
+
+    result = SQLT::dropAllTables<bulk_db>(&errMsg);        SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::open<bulk_db>(&db);                     SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::createAllTables<bulk_db>(db, &errMsg);  SQLT_ASSERT(result == SQLITE_OK);
+
+    std::vector<bulk_db::Measurement> measurements = makeMeasurements(3000);
+    result = SQLT::bulkInsert(db, measurements, 0);        SQLT_ASSERT(result == SQLITE_OK);
+
+    // 1. Single column keys, in several chunks including a shorter last chunk. Missing keys are not counted.
+    std::vector<int> keys;
+    for (int id = 0; id < 3000; id += 2)
+        keys.push_back(id);
+    keys.push_back(5000);
+    int64_t deleted = -1;
+    result = SQLT::deleteByKeys<bulk_db::Measurement>(db, keys, &deleted, 200);
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(deleted == 1500);
+    SQLT_ASSERT(rowCount(db, "Measurement") == 1500);
+
+    std::vector<int> ids;
+    result = SQLT::select<bulk_db>(db, &bulk_db::Measurement::id, &ids);
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(ids[0] == 1 && ids[1] == 3 && ids[1499] == 2999);
+
+    // 2. Inside an open transaction, rolled back with it.
+    result = SQLT::begin<bulk_db>(db);                     SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::deleteByKeys<bulk_db::Measurement>(db, std::vector<int>({ 1, 3, 5 }), &deleted);
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(deleted == 3);
+    SQLT_ASSERT(rowCount(db, "Measurement") == 1497);
+    result = SQLT::rollback<bulk_db>(db);                  SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(rowCount(db, "Measurement") == 1500);
+
+    // 3. Composite keys from key rows, only the primary key members are used.
+    std::vector<bulk_db::Annotation> annotations;
+    for (int i = 0; i < 50; i++)
+    {
+        annotations.push_back({ i, "a", "author" });
+        annotations.push_back({ i, "b", "author" });
+    }
+    result = SQLT::insert(db, annotations);                SQLT_ASSERT(result == SQLITE_OK);
+
+    std::vector<bulk_db::Annotation> annotationKeys;
+    for (int i = 0; i < 50; i++)
+        annotationKeys.push_back({ i, i < 25 ? "a" : "b", "" });
+    annotationKeys.push_back({ 100, "a", "" });
+    result = SQLT::deleteByKeys(db, annotationKeys, &deleted, 16);
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(deleted == 50);
+    SQLT_ASSERT(rowCount(db, "Annotation") == 50);
+
+    std::vector<bulk_db::Annotation> remaining;
+    result = SQLT::selectAll(db, &remaining);              SQLT_ASSERT(result == SQLITE_OK);
+    for (const auto& annotation : remaining)
+        SQLT_ASSERT(annotation.text == (annotation.measurement_id < 25 ? "b" : "a"));
+
+    // 4. Keys of other integer types than the key column.
+    result = SQLT::deleteByKeys<bulk_db::Measurement>(db, std::vector<long long>({ 1, 3 }), &deleted);
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(deleted == 2);
+    result = SQLT::deleteByKeys<bulk_db::Measurement>(db, std::vector<size_t>({ 5, 7, 9 }), &deleted);
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(deleted == 3);
+    SQLT_ASSERT(rowCount(db, "Measurement") == 1495);
+
+    // 5. Keys of a table with a composite primary key must be given as key rows.
+    result = SQLT::deleteByKeys<bulk_db::Annotation>(db, std::vector<int>({ 1 }), &deleted);
+    SQLT_ASSERT(result == SQLITE_MISUSE);
+
+    result = SQLT::close<bulk_db>(db);                     SQLT_ASSERT(result == SQLITE_OK);
+}
+
+void testUpdateColumns()
+{
+    char *errMsg;
+    int result;
+    sqlite3 *db;
+
+    result = SQLT::dropAllTables<bulk_db>(&errMsg);        SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::open<bulk_db>(&db);                     SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::createAllTables<bulk_db>(db, &errMsg);  SQLT_ASSERT(result == SQLITE_OK);
+
+    std::vector<bulk_db::Sensor> sensors;
+    for (int i = 0; i < 10; i++)
+        sensors.push_back({ i, "sensor" + std::to_string(i), "room" + std::to_string(i), 1.0, false });
+    result = SQLT::insert(db, sensors);                    SQLT_ASSERT(result == SQLITE_OK);
+
+    // 1. Only the given columns are written, the other members of the rows are ignored.
+    for (auto& sensor : sensors)
+    {
+        sensor.name = "ignored";
+        sensor.location = "ignored";
+        sensor.threshold = sensor.id * 10.0;
+        sensor.enabled = sensor.id % 2 == 0;
+    }
+    int64_t changes = 0;
+    result = SQLT::updateColumns(db, sensors, &changes, &bulk_db::Sensor::threshold, &bulk_db::Sensor::enabled);
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(changes == 10);
+
+    std::vector<bulk_db::Sensor> selected;
+    result = SQLT::selectAll(db, &selected);               SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(selected.size() == 10);
+    SQLT_ASSERT(selected[4].name == "sensor4" && selected[4].location == "room4");
+    SQLT_FUZZY_ASSERT(selected[4].threshold, 40.0);
+    SQLT_ASSERT(selected[4].enabled && !selected[5].enabled);
+
+    // 2. One cached statement per combination of columns, regardless of the order of the members.
+    {
+        SQLT::StatementCache cache(db);
+        result = SQLT::updateColumns(cache, sensors, &bulk_db::Sensor::location);
+        SQLT_ASSERT(result == SQLITE_OK);
+        result = SQLT::updateColumns(cache, sensors, &bulk_db::Sensor::enabled, &bulk_db::Sensor::name);
+        SQLT_ASSERT(result == SQLITE_OK);
+        result = SQLT::updateColumns(cache, sensors, &changes, &bulk_db::Sensor::name, &bulk_db::Sensor::enabled);
+        SQLT_ASSERT(result == SQLITE_OK);
+        SQLT_ASSERT(changes == 10);
+        SQLT_ASSERT(cache.misses() == 2 && cache.hits() == 1);
+    }
+
+    selected.clear();
+    result = SQLT::selectAll(db, &selected);               SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(selected[7].name == "ignored" && selected[7].location == "ignored");
+    SQLT_FUZZY_ASSERT(selected[7].threshold, 70.0);
+
+    // 3. Bool columns can be selected by member as well.
+    std::vector<bool> enabled;
+    result = SQLT::select<bulk_db>(db, &bulk_db::Sensor::enabled, &enabled);
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(enabled.size() == 10 && enabled[0] && !enabled[1]);
+
+    result = SQLT::close<bulk_db>(db);                     SQLT_ASSERT(result == SQLITE_OK);
+}
+
+void testSync()
+{
+    char *errMsg;
+    int result;
+    sqlite3 *db;
+
+    result = SQLT::dropAllTables<bulk_db>(&errMsg);        SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::open<bulk_db>(&db);                     SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::createAllTables<bulk_db>(db, &errMsg);  SQLT_ASSERT(result == SQLITE_OK);
+
+    std::vector<bulk_db::Device> state;
+    for (int i = 0; i < 100; i++)
+        state.push_back({ i, "device" + std::to_string(i), "room", 1.0, true, { /*NULL*/ } });
+
+    // 1. Syncing from an empty state inserts all rows.
+    SQLT::SyncCounts counts;
+    result = SQLT::sync(db, std::vector<bulk_db::Device>(), state, &counts);
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(counts.inserted == 100 && counts.updated == 0 && counts.deleted == 0);
+
+    // 2. Only changed rows are written, regardless of the order of the rows.
+    std::vector<bulk_db::Device> next = state;
+    std::reverse(next.begin(), next.end());
+    next[0].threshold = 2.0;                               // id 99
+    next[1].note = "calibrated";                           // id 98
+    next[2].enabled = false;                               // id 97
+    next.erase(next.begin() + 10, next.begin() + 15);      // ids 85-89
+    next.push_back({ 100, "device100", "hall", 1.0, true, { /*NULL*/ } });
+    result = SQLT::sync(db, state, next, &counts);
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(counts.inserted == 1 && counts.updated == 3 && counts.deleted == 5);
+
+    std::vector<bulk_db::Device> selected;
+    result = SQLT::selectAll(db, &selected);               SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(selected.size() == 96);
+    SQLT_ASSERT(selected[84].id == 84 && selected[85].id == 90);
+    SQLT_ASSERT(selected[92].id == 97 && !selected[92].enabled);
+    SQLT_ASSERT(selected[93].id == 98 && !selected[93].note.is_null && selected[93].note.value == "calibrated");
+    SQLT_FUZZY_ASSERT(selected[94].threshold, 2.0);
+    SQLT_ASSERT(selected[95].id == 100 && selected[95].location == "hall");
+
+    // 3. Nothing is written when nothing changed, and a NULL that becomes a value again is an update.
+    result = SQLT::sync(db, next, next, &counts);          SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(counts.inserted == 0 && counts.updated == 0 && counts.deleted == 0);
+    state = next;
+    next[1].note.is_null = true;
+    result = SQLT::sync(db, state, next, &counts);         SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(counts.updated == 1);
+
+    // 4. A failing change rolls back all changes.
+    state = next;
+    next[0].threshold = 3.0;
+    next.push_back({ 200, "device200", "hall", 1.0, true, { /*NULL*/ } });
+    result = sqlite3_exec(db, "INSERT INTO Device VALUES(200, 'existing', 'hall', 1.0, 1, NULL);", NULL, NULL, NULL);
+    SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::sync(db, state, next, &counts);
+    SQLT_ASSERT(result == SQLITE_CONSTRAINT);
+    SQLT_ASSERT(counts.inserted == 0 && counts.updated == 0);
+    selected.clear();
+    result = SQLT::selectAll(db, &selected);               SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_FUZZY_ASSERT(selected[94].threshold, 2.0);
+    SQLT_ASSERT(sqlite3_get_autocommit(db) != 0);
+
+    result = SQLT::close<bulk_db>(db);                     SQLT_ASSERT(result == SQLITE_OK);
+}
+
+void testInsertOrder()
+{
+    char *errMsg;
+    int result;
+    sqlite3 *db;
+
+    result = SQLT::dropAllTables<bulk_db>(&errMsg);        SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::open<bulk_db>(&db);                     SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::createAllTables<bulk_db>(db, &errMsg);  SQLT_ASSERT(result == SQLITE_OK);
+
+    // The rows get their rowids in insertion order, so a table scan shows the order they were inserted in.
+    std::vector<bulk_db::Annotation> annotations({
+        { 3, "b", "x" }, { 1, "b", "x" }, { 2, "a", "x" }, { 3, "a", "x" }, { 1, "a", "x" }, { 2, "c", "x" }, { 1, "c", "x" }
+    });
+    const std::vector<bulk_db::Annotation> input = annotations;
+
+    // 1. Row at a time, sorted on all primary key columns. The input is left as is.
+    result = SQLT::insert(db, annotations, SQLT::InsertOrder::PRIMARY_KEY);
+    SQLT_ASSERT(result == SQLITE_OK);
+    for (size_t i = 0; i < annotations.size(); i++)
+        SQLT_ASSERT(annotations[i].measurement_id == input[i].measurement_id && annotations[i].text == input[i].text);
+
+    std::vector<bulk_db::Annotation> selected;
+    result = SQLT::selectAll(db, &selected);               SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(selected.size() == 7);
+    for (size_t i = 1; i < selected.size(); i++)
+        SQLT_ASSERT(selected[i - 1].measurement_id < selected[i].measurement_id ||
+                    (selected[i - 1].measurement_id == selected[i].measurement_id && selected[i - 1].text < selected[i].text));
+
+    // 2. Batched, with a remainder statement.
+    result = SQLT::deleteAll<bulk_db::Annotation>(db);     SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::insertBatched(db, annotations, 3, SQLT::InsertOrder::PRIMARY_KEY);
+    SQLT_ASSERT(result == SQLITE_OK);
+    selected.clear();
+    result = SQLT::selectAll(db, &selected);               SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(selected.size() == 7);
+    SQLT_ASSERT(selected[0].measurement_id == 1 && selected[0].text == "a");
+    SQLT_ASSERT(selected[3].measurement_id == 2 && selected[3].text == "a");
+    SQLT_ASSERT(selected[6].measurement_id == 3 && selected[6].text == "b");
+
+    // 3. Given order is the default.
+    result = SQLT::deleteAll<bulk_db::Annotation>(db);     SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::insertBatched(db, annotations, 3);      SQLT_ASSERT(result == SQLITE_OK);
+    selected.clear();
+    result = SQLT::selectAll(db, &selected);               SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(selected[0].measurement_id == 3 && selected[0].text == "b");
+
+    result = SQLT::close<bulk_db>(db);                     SQLT_ASSERT(result == SQLITE_OK);
+}
+
+void testInsertSkippingFailures()
+{
+    char *errMsg;
+    int result;
+    sqlite3 *db;
+
+    result = SQLT::dropAllTables<bulk_db>(&errMsg);        SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::open<bulk_db>(&db);                     SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::createAllTables<bulk_db>(db, &errMsg);  SQLT_ASSERT(result == SQLITE_OK);
+
+    std::vector<bulk_db::Measurement> existing = makeMeasurements(1, 500);
+    result = SQLT::insert(db, existing);                   SQLT_ASSERT(result == SQLITE_OK);
+
+    // 1. Duplicates within the rows and of existing rows are skipped, the other rows are inserted.
+    std::vector<bulk_db::Measurement> measurements = makeMeasurements(1000);
+    measurements[10].id = measurements[3].id;
+    measurements[999].id = measurements[0].id;
+    std::vector<SQLT::InsertFailure> failures;
+    size_t inserted = 0;
+    result = SQLT::insertSkippingFailures(db, measurements, &failures, &inserted);
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(inserted == 997);
+    SQLT_ASSERT(failures.size() == 3);
+    SQLT_ASSERT(failures[0].index == 10 && failures[0].errorCode == SQLITE_CONSTRAINT_PRIMARYKEY);
+    SQLT_ASSERT(failures[1].index == 500 && failures[1].errorCode == SQLITE_CONSTRAINT_PRIMARYKEY);
+    SQLT_ASSERT(failures[2].index == 999);
+    SQLT_ASSERT(rowCount(db, "Measurement") == 998);
+    SQLT_ASSERT(sqlite3_get_autocommit(db) != 0);
+
+    // 2. Inside a transaction, through the statement cache. Ids 990-998 exist, id 999 was skipped above.
+    {
+        SQLT::StatementCache cache(db);
+        failures.clear();
+        result = SQLT::begin<bulk_db>(db);                 SQLT_ASSERT(result == SQLITE_OK);
+        result = SQLT::insertSkippingFailures(cache, makeMeasurements(20, 990), &failures, &inserted);
+        SQLT_ASSERT(result == SQLITE_OK);
+        SQLT_ASSERT(inserted == 11 && failures.size() == 9);
+        SQLT_ASSERT(failures[0].index == 0 && failures[8].index == 8);
+        result = SQLT::commit<bulk_db>(db);                SQLT_ASSERT(result == SQLITE_OK);
+        SQLT_ASSERT(rowCount(db, "Measurement") == 1009);
+    }
+
+    // 3. Other errors roll back all rows.
+    sqlite3 *other;
+    result = SQLT::open<bulk_db>(&other);                  SQLT_ASSERT(result == SQLITE_OK);
+    result = sqlite3_exec(other, "BEGIN IMMEDIATE;", NULL, NULL, NULL);
+    SQLT_ASSERT(result == SQLITE_OK);
+    failures.clear();
+    result = SQLT::insertSkippingFailures(db, makeMeasurements(10, 2000), &failures, &inserted);
+    SQLT_ASSERT(result == SQLITE_BUSY);
+    SQLT_ASSERT(inserted == 0 && failures.empty());
+    result = sqlite3_exec(other, "ROLLBACK;", NULL, NULL, NULL);
+    SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::close<bulk_db>(other);                  SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(rowCount(db, "Measurement") == 1009);
+    SQLT_ASSERT(sqlite3_get_autocommit(db) != 0);
+
+    result = SQLT::close<bulk_db>(db);                     SQLT_ASSERT(result == SQLITE_OK);
+}
+
+void testInsertViaVirtualTable()
+{
+    char *errMsg;
+    int result;
+    sqlite3 *db;
+
+    result = SQLT::dropAllTables<bulk_db>(&errMsg);        SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::open<bulk_db>(&db);                     SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::createAllTables<bulk_db>(db, &errMsg);  SQLT_ASSERT(result == SQLITE_OK);
+
+    // 1. All column types, including NULL, are read from the vector.
+    std::vector<bulk_db::Reading> readings;
+    for (int i = 0; i < 100; i++)
+    {
+        readings.push_back({ i, "reading" + std::to_string(i), i * 0.5, i % 2 == 0,
+                             (i % 5 == 0) ? SQLT::Nullable<int>() : SQLT::Nullable<int>(i),
+                             (i % 3 == 0) ? SQLT::Nullable<std::string>() : SQLT::Nullable<std::string>("comment") });
+    }
+    result = SQLT::insertViaVirtualTable(db, readings);    SQLT_ASSERT(result == SQLITE_OK);
+
+    std::vector<bulk_db::Reading> selected;
+    result = SQLT::selectAll(db, &selected);               SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(selected.size() == readings.size());
+    for (size_t i = 0; i < readings.size(); i++)
+        SQLT_ASSERT(SQLT::Internal::compareRows(selected[i], readings[i], SQLT::Internal::ColumnFilter::ALL) == 0);
+
+    // 2. The module is registered once per connection and per table, and an empty vector inserts nothing.
+    result = SQLT::insertViaVirtualTable(db, makeMeasurements(10));
+    SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::insertViaVirtualTable(db, makeMeasurements(10, 10));
+    SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::insertViaVirtualTable(db, std::vector<bulk_db::Measurement>());
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(rowCount(db, "Measurement") == 20);
+
+    // 3. A failing row fails the whole statement.
+    result = SQLT::insertViaVirtualTable(db, makeMeasurements(10, 15));
+    SQLT_ASSERT(result == SQLITE_CONSTRAINT);
+    SQLT_ASSERT(rowCount(db, "Measurement") == 20);
+
+    // 4. The virtual table of a table only reads vectors of that table.
+    const std::vector<bulk_db::Measurement> measurements = makeMeasurements(3);
+    sqlite3_stmt *stmt;
+    result = sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM sqlt_vector_Reading(?);", -1, &stmt, NULL);
+    SQLT_ASSERT(result == SQLITE_OK);
+    result = sqlite3_bind_pointer(stmt, 1, const_cast<std::vector<bulk_db::Measurement>*>(&measurements),
+                                  SQLT::Internal::VectorTable<bulk_db::Measurement>::pointerType(), nullptr);
+    SQLT_ASSERT(result == SQLITE_OK);
+    result = sqlite3_step(stmt);                           SQLT_ASSERT(result == SQLITE_ROW);
+    SQLT_ASSERT(sqlite3_column_int(stmt, 0) == 0);
+    sqlite3_reset(stmt);
+    result = sqlite3_bind_pointer(stmt, 1, &readings, SQLT::Internal::VectorTable<bulk_db::Reading>::pointerType(), nullptr);
+    SQLT_ASSERT(result == SQLITE_OK);
+    result = sqlite3_step(stmt);                           SQLT_ASSERT(result == SQLITE_ROW);
+    SQLT_ASSERT(sqlite3_column_int(stmt, 0) == 100);
+    sqlite3_finalize(stmt);
+
+    // 5. A missing table to insert into is reported, rather than taken for a missing module.
+    result = SQLT::dropTableIfExists<bulk_db::Annotation>(db, &errMsg);
+    SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::insertViaVirtualTable(db, std::vector<bulk_db::Annotation>({ { 1, "a", "author" } }));
+    SQLT_ASSERT(result == SQLITE_ERROR);
+    SQLT_ASSERT(std::string(sqlite3_errmsg(db)) == "no such table: Annotation");
+
+    result = SQLT::close<bulk_db>(db);                     SQLT_ASSERT(result == SQLITE_OK);
+}
+
+int main()
+{
+    testBulkInsert();
+    testUpsert();
+    testStreamingInsert();
+    testBulkLoadSession();
+    testInsertReturningIds();
+    testUpdate();
+    testDeleteByKeys();
+    testUpdateColumns();
+    testSync();
+    testInsertOrder();
+    testInsertSkippingFailures();
+    testInsertViaVirtualTable();
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include "assert.h"
+
+#include <sqlite3/sqlite3.h>
+#include <sqlite_tools.h>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct cursor_db
+{
+    struct Item
+    {
+        int id;
+        std::string name;
+        SQLT::Nullable<double> value;
+
+        SQLT_TABLE(Item,
+            SQLT_COLUMN_PRIMARY_KEY(id),
+            SQLT_COLUMN(name),
+            SQLT_COLUMN(value)
+        );
+    };
+
+    SQLT_DATABASE_WITH_NAME(cursor_db, "cursor_db.sqlite",
+        SQLT_DATABASE_TABLE(Item)
+    );
+
+    struct ItemName
+    {
+        int id;
+        std::string name;
+
+        SQLT_QUERY_RESULT_STRUCT(ItemName,
+            SQLT_QUERY_RESULT_MEMBER(id),
+            SQLT_QUERY_RESULT_MEMBER(name)
+        );
+    };
+};
+
+int main()
+{
+    static const int COUNT = 100;
+
+    char *errMsg;
+    int result;
+    sqlite3 *db;
+
+    result = SQLT::dropAllTables<cursor_db>(&errMsg);        SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::open<cursor_db>(&db);                     SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::createAllTables<cursor_db>(db, &errMsg);  SQLT_ASSERT(result == SQLITE_OK);
+
+    std::vector<cursor_db::Item> items;
+    for (int i = 0; i < COUNT; i++)
+    {
+        cursor_db::Item item = { i, "item" + std::to_string(i), { /*NULL*/ } };
+        if (i % 3 == 0)
+            item.value = 0.5 * i;
+        items.push_back(item);
+    }
+    result = SQLT::insert(db, items);                        SQLT_ASSERT(result == SQLITE_OK);
+
+    // 1. All rows of a table in a range-for.
+    {
+        SQLT::Cursor<cursor_db::Item> cursor(db);
+        int count = 0;
+        for (const cursor_db::Item& item : cursor)
+        {
+            SQLT_ASSERT(item.id == count);
+            SQLT_ASSERT(item.name == items[count].name);
+            SQLT_ASSERT(item.value.is_null == (count % 3 != 0));
+            count++;
+        }
+        SQLT_ASSERT(count == COUNT);
+        SQLT_ASSERT(cursor.result() == SQLITE_OK);
+        SQLT_ASSERT(cursor.begin() == cursor.end());
+
+        // The rows can be iterated again after a reset.
+        cursor.reset();
+        SQLT_ASSERT(cursor.begin() != cursor.end());
+        SQLT_ASSERT(cursor.begin()->id == 0);
+    }
+
+    // 2. A custom query with parameters in a standard algorithm, stopping at the first match.
+    {
+        SQLT::Cursor<cursor_db::ItemName> cursor(db, "SELECT id, name FROM Item WHERE id >= ? ORDER BY id;", SQLT::params(40));
+        auto it = std::find_if(cursor.begin(), cursor.end(), [](const cursor_db::ItemName& item) { return item.id % 7 == 0; });
+        SQLT_ASSERT(it != cursor.end());
+        SQLT_ASSERT(it->id == 42 && it->name == "item42");
+
+        // The iteration continues from the current row.
+        ++it;
+        SQLT_ASSERT(it->id == 43);
+    }
+
+    // 3. Moving a cursor keeps its position.
+    {
+        SQLT::Cursor<cursor_db::ItemName> cursor(db, "SELECT name, id FROM Item ORDER BY id DESC;");
+        SQLT_ASSERT(cursor.begin()->id == COUNT - 1);
+        SQLT::Cursor<cursor_db::ItemName> moved(std::move(cursor));
+        auto it = moved.begin();
+        SQLT_ASSERT(it->id == COUNT - 1);
+        ++it;
+        SQLT_ASSERT(it->id == COUNT - 2 && it->name == "item98");
+    }
+
+    // 4. Cached statements are reset instead of finalized, and reused by the next cursor.
+    {
+        SQLT::StatementCache cache(db);
+        for (int i = 0; i < 3; i++)
+        {
+            SQLT::Cursor<cursor_db::ItemName> cursor(cache, "SELECT id, name FROM Item WHERE id = ?;", SQLT::params(i));
+            auto it = cursor.begin();
+            SQLT_ASSERT(it != cursor.end() && it->id == i);
+            SQLT_ASSERT(++it == cursor.end());
+
+            SQLT::Cursor<cursor_db::Item> all(cache);
+            SQLT_ASSERT(all.begin()->id == 0);
+        }
+        SQLT_ASSERT(cache.size() == 2);
+        SQLT_ASSERT(cache.misses() == 2);
+        SQLT_ASSERT(cache.hits() == 4);
+
+        // The cursors leave no statement pending, so the table can be written to.
+        result = SQLT::deleteAll<cursor_db::Item>(cache);   SQLT_ASSERT(result == SQLITE_OK);
+        result = SQLT::insert(cache, items);                 SQLT_ASSERT(result == SQLITE_OK);
+    }
+
+    // 5. Errors end the iteration and are reported by result().
+    {
+        SQLT::Cursor<cursor_db::ItemName> cursor(db, "SELECT id, name FROM NoSuchTable;");
+        SQLT_ASSERT(cursor.result() == SQLITE_ERROR);
+        SQLT_ASSERT(cursor.begin() == cursor.end());
+    }
+
+    result = SQLT::close<cursor_db>(db);                     SQLT_ASSERT(result == SQLITE_OK);
+
+    return 0;
+}
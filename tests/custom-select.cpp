@@ -0,0 +1,384 @@
+#include "assert.h"
+
+#include <sqlite3/sqlite3.h>
+#include <sqlite_tools.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// A wide table and a query struct with the same 40 columns, to measure the decoding of custom query results.
+struct select_db
+{
+    struct Wide
+    {
+        int c00;
+        double c01;
+        std::string c02;
+        SQLT::Nullable<int> c03;
+        int c04;
+        double c05;
+        std::string c06;
+        SQLT::Nullable<int> c07;
+        int c08;
+        double c09;
+        std::string c10;
+        SQLT::Nullable<int> c11;
+        int c12;
+        double c13;
+        std::string c14;
+        SQLT::Nullable<int> c15;
+        int c16;
+        double c17;
+        std::string c18;
+        SQLT::Nullable<int> c19;
+        int c20;
+        double c21;
+        std::string c22;
+        SQLT::Nullable<int> c23;
+        int c24;
+        double c25;
+        std::string c26;
+        SQLT::Nullable<int> c27;
+        int c28;
+        double c29;
+        std::string c30;
+        SQLT::Nullable<int> c31;
+        int c32;
+        double c33;
+        std::string c34;
+        SQLT::Nullable<int> c35;
+        int c36;
+        double c37;
+        std::string c38;
+        SQLT::Nullable<int> c39;
+
+        SQLT_TABLE(Wide,
+            SQLT_COLUMN_PRIMARY_KEY(c00),
+            SQLT_COLUMN(c01),
+            SQLT_COLUMN(c02),
+            SQLT_COLUMN(c03),
+            SQLT_COLUMN(c04),
+            SQLT_COLUMN(c05),
+            SQLT_COLUMN(c06),
+            SQLT_COLUMN(c07),
+            SQLT_COLUMN(c08),
+            SQLT_COLUMN(c09),
+            SQLT_COLUMN(c10),
+            SQLT_COLUMN(c11),
+            SQLT_COLUMN(c12),
+            SQLT_COLUMN(c13),
+            SQLT_COLUMN(c14),
+            SQLT_COLUMN(c15),
+            SQLT_COLUMN(c16),
+            SQLT_COLUMN(c17),
+            SQLT_COLUMN(c18),
+            SQLT_COLUMN(c19),
+            SQLT_COLUMN(c20),
+            SQLT_COLUMN(c21),
+            SQLT_COLUMN(c22),
+            SQLT_COLUMN(c23),
+            SQLT_COLUMN(c24),
+            SQLT_COLUMN(c25),
+            SQLT_COLUMN(c26),
+            SQLT_COLUMN(c27),
+            SQLT_COLUMN(c28),
+            SQLT_COLUMN(c29),
+            SQLT_COLUMN(c30),
+            SQLT_COLUMN(c31),
+            SQLT_COLUMN(c32),
+            SQLT_COLUMN(c33),
+            SQLT_COLUMN(c34),
+            SQLT_COLUMN(c35),
+            SQLT_COLUMN(c36),
+            SQLT_COLUMN(c37),
+            SQLT_COLUMN(c38),
+            SQLT_COLUMN(c39)
+        );
+    };
+
+    // A table of long texts, to measure the decoding of TEXT columns.
+    struct Document
+    {
+        int id;
+        std::string title;
+        std::string author;
+        std::string summary;
+        std::string body;
+
+        SQLT_TABLE(Document,
+            SQLT_COLUMN_PRIMARY_KEY(id),
+            SQLT_COLUMN(title),
+            SQLT_COLUMN(author),
+            SQLT_COLUMN(summary),
+            SQLT_COLUMN(body)
+        );
+    };
+
+    SQLT_DATABASE_WITH_NAME(select_db, "select_db.sqlite",
+        SQLT_DATABASE_TABLE(Wide),
+        SQLT_DATABASE_TABLE(Document)
+    );
+
+    struct WideResult
+    {
+        int c00;
+        double c01;
+        std::string c02;
+        SQLT::Nullable<int> c03;
+        int c04;
+        double c05;
+        std::string c06;
+        SQLT::Nullable<int> c07;
+        int c08;
+        double c09;
+        std::string c10;
+        SQLT::Nullable<int> c11;
+        int c12;
+        double c13;
+        std::string c14;
+        SQLT::Nullable<int> c15;
+        int c16;
+        double c17;
+        std::string c18;
+        SQLT::Nullable<int> c19;
+        int c20;
+        double c21;
+        std::string c22;
+        SQLT::Nullable<int> c23;
+        int c24;
+        double c25;
+        std::string c26;
+        SQLT::Nullable<int> c27;
+        int c28;
+        double c29;
+        std::string c30;
+        SQLT::Nullable<int> c31;
+        int c32;
+        double c33;
+        std::string c34;
+        SQLT::Nullable<int> c35;
+        int c36;
+        double c37;
+        std::string c38;
+        SQLT::Nullable<int> c39;
+
+        SQLT_QUERY_RESULT_STRUCT(WideResult,
+            SQLT_QUERY_RESULT_MEMBER(c00),
+            SQLT_QUERY_RESULT_MEMBER(c01),
+            SQLT_QUERY_RESULT_MEMBER(c02),
+            SQLT_QUERY_RESULT_MEMBER(c03),
+            SQLT_QUERY_RESULT_MEMBER(c04),
+            SQLT_QUERY_RESULT_MEMBER(c05),
+            SQLT_QUERY_RESULT_MEMBER(c06),
+            SQLT_QUERY_RESULT_MEMBER(c07),
+            SQLT_QUERY_RESULT_MEMBER(c08),
+            SQLT_QUERY_RESULT_MEMBER(c09),
+            SQLT_QUERY_RESULT_MEMBER(c10),
+            SQLT_QUERY_RESULT_MEMBER(c11),
+            SQLT_QUERY_RESULT_MEMBER(c12),
+            SQLT_QUERY_RESULT_MEMBER(c13),
+            SQLT_QUERY_RESULT_MEMBER(c14),
+            SQLT_QUERY_RESULT_MEMBER(c15),
+            SQLT_QUERY_RESULT_MEMBER(c16),
+            SQLT_QUERY_RESULT_MEMBER(c17),
+            SQLT_QUERY_RESULT_MEMBER(c18),
+            SQLT_QUERY_RESULT_MEMBER(c19),
+            SQLT_QUERY_RESULT_MEMBER(c20),
+            SQLT_QUERY_RESULT_MEMBER(c21),
+            SQLT_QUERY_RESULT_MEMBER(c22),
+            SQLT_QUERY_RESULT_MEMBER(c23),
+            SQLT_QUERY_RESULT_MEMBER(c24),
+            SQLT_QUERY_RESULT_MEMBER(c25),
+            SQLT_QUERY_RESULT_MEMBER(c26),
+            SQLT_QUERY_RESULT_MEMBER(c27),
+            SQLT_QUERY_RESULT_MEMBER(c28),
+            SQLT_QUERY_RESULT_MEMBER(c29),
+            SQLT_QUERY_RESULT_MEMBER(c30),
+            SQLT_QUERY_RESULT_MEMBER(c31),
+            SQLT_QUERY_RESULT_MEMBER(c32),
+            SQLT_QUERY_RESULT_MEMBER(c33),
+            SQLT_QUERY_RESULT_MEMBER(c34),
+            SQLT_QUERY_RESULT_MEMBER(c35),
+            SQLT_QUERY_RESULT_MEMBER(c36),
+            SQLT_QUERY_RESULT_MEMBER(c37),
+            SQLT_QUERY_RESULT_MEMBER(c38),
+            SQLT_QUERY_RESULT_MEMBER(c39)
+        );
+    };
+
+    struct Renamed
+    {
+        int id;
+        double value;
+        std::string text;
+
+        SQLT_QUERY_RESULT_STRUCT(Renamed,
+            SQLT_QUERY_RESULT_MEMBER(id),
+            SQLT_QUERY_RESULT_MEMBER(value),
+            SQLT_QUERY_RESULT_MEMBER(text)
+        );
+    };
+};
+
+select_db::Wide makeRow(int i)
+{
+    select_db::Wide row;
+    row.c00 = i;
+    row.c01 = i * 0.5 + 1;
+    row.c02 = "text" + std::to_string(i + 2);
+    row.c03 = (i % 2 == 0) ? SQLT::Nullable<int>() : SQLT::Nullable<int>(i + 3);
+    row.c04 = i + 4;
+    row.c05 = i * 0.5 + 5;
+    row.c06 = "text" + std::to_string(i + 6);
+    row.c07 = (i % 2 == 0) ? SQLT::Nullable<int>() : SQLT::Nullable<int>(i + 7);
+    row.c08 = i + 8;
+    row.c09 = i * 0.5 + 9;
+    row.c10 = "text" + std::to_string(i + 10);
+    row.c11 = (i % 2 == 0) ? SQLT::Nullable<int>() : SQLT::Nullable<int>(i + 11);
+    row.c12 = i + 12;
+    row.c13 = i * 0.5 + 13;
+    row.c14 = "text" + std::to_string(i + 14);
+    row.c15 = (i % 2 == 0) ? SQLT::Nullable<int>() : SQLT::Nullable<int>(i + 15);
+    row.c16 = i + 16;
+    row.c17 = i * 0.5 + 17;
+    row.c18 = "text" + std::to_string(i + 18);
+    row.c19 = (i % 2 == 0) ? SQLT::Nullable<int>() : SQLT::Nullable<int>(i + 19);
+    row.c20 = i + 20;
+    row.c21 = i * 0.5 + 21;
+    row.c22 = "text" + std::to_string(i + 22);
+    row.c23 = (i % 2 == 0) ? SQLT::Nullable<int>() : SQLT::Nullable<int>(i + 23);
+    row.c24 = i + 24;
+    row.c25 = i * 0.5 + 25;
+    row.c26 = "text" + std::to_string(i + 26);
+    row.c27 = (i % 2 == 0) ? SQLT::Nullable<int>() : SQLT::Nullable<int>(i + 27);
+    row.c28 = i + 28;
+    row.c29 = i * 0.5 + 29;
+    row.c30 = "text" + std::to_string(i + 30);
+    row.c31 = (i % 2 == 0) ? SQLT::Nullable<int>() : SQLT::Nullable<int>(i + 31);
+    row.c32 = i + 32;
+    row.c33 = i * 0.5 + 33;
+    row.c34 = "text" + std::to_string(i + 34);
+    row.c35 = (i % 2 == 0) ? SQLT::Nullable<int>() : SQLT::Nullable<int>(i + 35);
+    row.c36 = i + 36;
+    row.c37 = i * 0.5 + 37;
+    row.c38 = "text" + std::to_string(i + 38);
+    row.c39 = (i % 2 == 0) ? SQLT::Nullable<int>() : SQLT::Nullable<int>(i + 39);
+    return row;
+}
+
+void testColumnMapping(sqlite3 *db)
+{
+    // Result columns are matched by name regardless of their order, and result columns without a member are ignored.
+    std::vector<select_db::Renamed> renamed;
+    int result = SQLT::select(db, "SELECT c02 AS text, 7 AS unknown, c01 AS value, c00 AS id FROM Wide WHERE c00 < 3 ORDER BY c00;", &renamed);
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(renamed.size() == 3);
+    SQLT_ASSERT(renamed[2].id == 2 && renamed[2].text == makeRow(2).c02);
+    SQLT_FUZZY_ASSERT(renamed[2].value, makeRow(2).c01);
+}
+
+select_db::Document makeDocument(int i)
+{
+    const std::string number = std::to_string(i);
+    return { i, std::string(40, 't') + number, std::string(30, 'a') + number, std::string(200, 's') + number, std::string(1000, 'b') + number };
+}
+
+void benchmarkText(sqlite3 *db, int count, int repeat)
+{
+    std::vector<select_db::Document> documents;
+    documents.reserve(count);
+    for (int i = 0; i < count; i++)
+        documents.push_back(makeDocument(i));
+    int result = SQLT::begin<select_db>(db);               SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::insert(db, documents);                  SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::commit<select_db>(db);                  SQLT_ASSERT(result == SQLITE_OK);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeat; i++)
+    {
+        std::vector<select_db::Document> selected;
+        result = SQLT::selectAll(db, &selected, count);
+        SQLT_ASSERT(result == SQLITE_OK);
+        SQLT_ASSERT(selected.size() == (size_t)count);
+        SQLT_ASSERT(selected[123].body == documents[123].body);
+    }
+    auto end = std::chrono::steady_clock::now();
+    long long collected = (long long)std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    fprintf(stderr, "Selected %d x %d rows of long texts in %lld milliseconds (selectAll).\n", repeat, count, collected);
+
+    // Streamed rows are decoded into one struct, whose strings keep their capacity from row to row.
+    size_t bytes = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeat; i++)
+    {
+        result = SQLT::forEachAll<select_db::Document>(db, [&](const select_db::Document& document)
+        {
+            bytes += document.title.size() + document.author.size() + document.summary.size() + document.body.size();
+            return true;
+        });
+        SQLT_ASSERT(result == SQLITE_OK);
+    }
+    end = std::chrono::steady_clock::now();
+    long long streamed = (long long)std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    fprintf(stderr, "Selected %d x %d rows of long texts in %lld milliseconds (forEachAll).\n", repeat, count, streamed);
+    SQLT_ASSERT(bytes > (size_t)repeat * count * 1270);
+}
+
+int main()
+{
+    static const int COUNT = 20000;
+    static const int REPEAT = 5;
+
+    char *errMsg;
+    int result;
+    sqlite3 *db;
+
+    result = SQLT::dropAllTables<select_db>(&errMsg);        SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::open<select_db>(&db);                     SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::createAllTables<select_db>(db, &errMsg);  SQLT_ASSERT(result == SQLITE_OK);
+
+    std::vector<select_db::Wide> rows;
+    rows.reserve(COUNT);
+    for (int i = 0; i < COUNT; i++)
+        rows.push_back(makeRow(i));
+    result = SQLT::begin<select_db>(db);                     SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::insert(db, rows);                         SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::commit<select_db>(db);                    SQLT_ASSERT(result == SQLITE_OK);
+
+    testColumnMapping(db);
+
+    // Custom query, decoded by result column name.
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < REPEAT; i++)
+    {
+        std::vector<select_db::WideResult> selected;
+        result = SQLT::select(db, "SELECT * FROM Wide;", &selected, COUNT);
+        SQLT_ASSERT(result == SQLITE_OK);
+        SQLT_ASSERT(selected.size() == COUNT);
+        SQLT_ASSERT(selected[123].c00 == 123 && selected[123].c38 == rows[123].c38);
+        SQLT_ASSERT(!selected[123].c39.is_null && selected[123].c39.value == rows[123].c39.value && selected[124].c39.is_null);
+    }
+    auto end = std::chrono::steady_clock::now();
+    long long byName = (long long)std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    fprintf(stderr, "Selected %d x %d rows of 40 columns in %lld milliseconds (custom query).\n", REPEAT, COUNT, byName);
+
+    // selectAll, decoded by column index, for reference.
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < REPEAT; i++)
+    {
+        std::vector<select_db::Wide> selected;
+        result = SQLT::selectAll(db, &selected, COUNT);
+        SQLT_ASSERT(result == SQLITE_OK);
+        SQLT_ASSERT(selected.size() == COUNT);
+    }
+    end = std::chrono::steady_clock::now();
+    long long byIndex = (long long)std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    fprintf(stderr, "Selected %d x %d rows of 40 columns in %lld milliseconds (selectAll).\n", REPEAT, COUNT, byIndex);
+
+    benchmarkText(db, COUNT, REPEAT);
+
+    result = SQLT::close<select_db>(db);                     SQLT_ASSERT(result == SQLITE_OK);
+    return 0;
+}
@@ -6,6 +6,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <vector>
+#include <algorithm>
 #include <string>
 #include <chrono>
 
@@ -56,17 +57,42 @@ double rand_flt()
 	return float(rand()) / float(RAND_MAX) * 54312;
 }
 
-int main()
+struct RowCount
 {
-	static const int COUNT = 1e6;
-	srand(34512);
+	int count;
 
-	// Generate random data set.
-	std::vector<large_db::Data> data;
-	data.reserve(COUNT);
-	for (size_t i = 0; i < COUNT; i++)
-		data.emplace_back(rand(), rand_str(), rand_flt());
+	SQLT_QUERY_RESULT_STRUCT(RowCount,
+		SQLT_QUERY_RESULT_MEMBER(count)
+	);
+};
+
+enum class InsertMode
+{
+	ROW_AT_A_TIME,
+	BATCHED,
+	VIRTUAL_TABLE
+};
+
+struct PageCount
+{
+	int page_count;
+
+	SQLT_QUERY_RESULT_STRUCT(PageCount,
+		SQLT_QUERY_RESULT_MEMBER(page_count)
+	);
+};
+
+struct PageSize
+{
+	int page_size;
 
+	SQLT_QUERY_RESULT_STRUCT(PageSize,
+		SQLT_QUERY_RESULT_MEMBER(page_size)
+	);
+};
+
+long long timedInsert(const std::vector<large_db::Data>& data, InsertMode mode, SQLT::InsertOrder order, long long *fileSize)
+{
 	char *errMsg;
 	int result = SQLT::dropAllTables<large_db>(&errMsg);
 	SQLT_ASSERT(result == SQLITE_OK);
@@ -75,20 +101,72 @@ int main()
 
 	sqlite3 *db;
 	result = SQLT::open<large_db>(&db);
-	if (result == SQLITE_OK)
-	{
-		// When performing more than a few SQL queries we should wrap the calls in a transaction.
-		result = SQLT::begin<large_db>(db);                    assert(result == SQLITE_OK);
-		result = SQLT::createAllTables<large_db>(db, &errMsg); assert(result == SQLITE_OK);
-		result = SQLT::insert(db, data);                       assert(result == SQLITE_OK);
-		result = SQLT::commit<large_db>(db);                   assert(result == SQLITE_OK);
-	}
+	SQLT_ASSERT(result == SQLITE_OK);
 
-	SQLT::close<large_db>(db);
+	// When performing more than a few SQL queries we should wrap the calls in a transaction.
+	result = SQLT::begin<large_db>(db);                    SQLT_ASSERT(result == SQLITE_OK);
+	result = SQLT::createAllTables<large_db>(db, &errMsg); SQLT_ASSERT(result == SQLITE_OK);
+	if (mode == InsertMode::ROW_AT_A_TIME)
+		result = SQLT::insert(db, data, order);
+	else if (mode == InsertMode::BATCHED)
+		result = SQLT::insertBatched(db, data, 0, order);
+	else
+		result = SQLT::insertViaVirtualTable(db, data);
+	SQLT_ASSERT(result == SQLITE_OK);
+	result = SQLT::commit<large_db>(db);                   SQLT_ASSERT(result == SQLITE_OK);
 
 	auto end = std::chrono::system_clock::now();
-	auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-	fprintf(stderr, "Inserted %d elements in %lld milliseconds.\n", COUNT, milliseconds.count());
+
+	std::vector<RowCount> rowCount;
+	result = SQLT::select(db, "SELECT COUNT(*) AS count FROM Data;", &rowCount, 1);
+	SQLT_ASSERT(result == SQLITE_OK);
+	SQLT_ASSERT(rowCount.size() == 1 && rowCount[0].count == (int)data.size());
+
+	std::vector<PageCount> pageCount;
+	std::vector<PageSize> pageSize;
+	result = SQLT::select(db, "PRAGMA page_count;", &pageCount, 1); SQLT_ASSERT(result == SQLITE_OK);
+	result = SQLT::select(db, "PRAGMA page_size;", &pageSize, 1);   SQLT_ASSERT(result == SQLITE_OK);
+	*fileSize = (long long)pageCount[0].page_count * pageSize[0].page_size;
+
+	SQLT::close<large_db>(db);
+
+	return (long long)std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+}
+
+int main()
+{
+	static const int COUNT = 1e6;
+	srand(34512);
+
+	// Generate random data set. The ids are unique but in random order.
+	std::vector<int> ids(COUNT);
+	for (int i = 0; i < COUNT; i++)
+		ids[i] = i;
+	for (int i = COUNT - 1; i > 0; i--)
+		std::swap(ids[i], ids[rand() % (i + 1)]);
+
+	std::vector<large_db::Data> data;
+	data.reserve(COUNT);
+	for (size_t i = 0; i < COUNT; i++)
+		data.emplace_back(ids[i], rand_str(), rand_flt());
+
+	// Insert the ids in their random order and sorted by primary key, which appends to the table B-tree instead of
+	// splitting pages all over it.
+	long long fileSize;
+	long long rowAtATime = timedInsert(data, InsertMode::ROW_AT_A_TIME, SQLT::InsertOrder::AS_GIVEN, &fileSize);
+	fprintf(stderr, "Inserted %d elements in %lld milliseconds, %lld bytes (row at a time).\n", COUNT, rowAtATime, fileSize);
+
+	long long batched = timedInsert(data, InsertMode::BATCHED, SQLT::InsertOrder::AS_GIVEN, &fileSize);
+	fprintf(stderr, "Inserted %d elements in %lld milliseconds, %lld bytes (batched).\n", COUNT, batched, fileSize);
+
+	long long virtualTable = timedInsert(data, InsertMode::VIRTUAL_TABLE, SQLT::InsertOrder::AS_GIVEN, &fileSize);
+	fprintf(stderr, "Inserted %d elements in %lld milliseconds, %lld bytes (virtual table).\n", COUNT, virtualTable, fileSize);
+
+	long long rowAtATimeSorted = timedInsert(data, InsertMode::ROW_AT_A_TIME, SQLT::InsertOrder::PRIMARY_KEY, &fileSize);
+	fprintf(stderr, "Inserted %d elements in %lld milliseconds, %lld bytes (row at a time, primary key order).\n", COUNT, rowAtATimeSorted, fileSize);
+
+	long long batchedSorted = timedInsert(data, InsertMode::BATCHED, SQLT::InsertOrder::PRIMARY_KEY, &fileSize);
+	fprintf(stderr, "Inserted %d elements in %lld milliseconds, %lld bytes (batched, primary key order).\n", COUNT, batchedSorted, fileSize);
 
 	return 0;
 }
@@ -33,11 +33,11 @@ struct Database
         int sometable_id;
         int someothertable_id;
 
-        SQLT_TABLE_WITH_NAME(ManyToManyTable, "mtm_resolver",  // SQLite table name = "mtm_resolver"
-            SQLT_COLUMN_PRIMARY_KEY(sometable_id),             // INTEGER NOT NULL
-            SQLT_COLUMN_PRIMARY_KEY(someothertable_id)         // INTEGER NOT NULL
-                                                               // PRIMARY_KEY(sometable_id, someothertable_id)
-        );
+        SQLT_TABLE_WITH_NAME_WITHOUT_ROWID(ManyToManyTable, "mtm_resolver",  // SQLite table name = "mtm_resolver"
+            SQLT_COLUMN_PRIMARY_KEY(sometable_id),                           // INTEGER NOT NULL
+            SQLT_COLUMN_PRIMARY_KEY(someothertable_id)                       // INTEGER NOT NULL
+                                                                             // PRIMARY_KEY(sometable_id, someothertable_id)
+        );                                                                   // WITHOUT ROWID
     };
 
     // Statically define another table with three columns.
@@ -46,7 +46,7 @@ struct recipes_db
             JS_MEMBER(ingredient_id)
         );
 
-        SQLT_TABLE(ingredient_in_recipe,
+        SQLT_TABLE_WITHOUT_ROWID(ingredient_in_recipe,
             SQLT_COLUMN_PRIMARY_KEY(recipe_id),
             SQLT_COLUMN_PRIMARY_KEY(ingredient_id)
         );
@@ -87,7 +87,7 @@ struct recipes_db
             JS_MEMBER(ingredient_id)
         );
 
-        SQLT_TABLE(allergen_in_ingredient,
+        SQLT_TABLE_WITHOUT_ROWID(allergen_in_ingredient,
             SQLT_COLUMN_PRIMARY_KEY(allergen_id),
             SQLT_COLUMN_PRIMARY_KEY(ingredient_id)
         );
@@ -0,0 +1,241 @@
+#include "assert.h"
+
+#include <sqlite3/sqlite3.h>
+#include <sqlite_tools.h>
+
+#include <vector>
+#include <string>
+
+struct cache_db
+{
+    struct Item
+    {
+        int id;
+        std::string name;
+        SQLT::Nullable<double> value;
+
+        SQLT_TABLE(Item,
+            SQLT_COLUMN_PRIMARY_KEY(id),
+            SQLT_COLUMN(name),
+            SQLT_COLUMN(value)
+        );
+    };
+
+    struct Tag
+    {
+        int item_id;
+        std::string tag;
+
+        SQLT_TABLE(Tag,
+            SQLT_COLUMN_PRIMARY_KEY(item_id),
+            SQLT_COLUMN_PRIMARY_KEY(tag)
+        );
+    };
+
+    SQLT_DATABASE_WITH_NAME(cache_db, "cache_db.sqlite",
+        SQLT_DATABASE_TABLE(Item),
+        SQLT_DATABASE_TABLE(Tag)
+    );
+
+    struct ItemName
+    {
+        int id;
+        std::string name;
+
+        SQLT_QUERY_RESULT_STRUCT(ItemName,
+            SQLT_QUERY_RESULT_MEMBER(id),
+            SQLT_QUERY_RESULT_MEMBER(name)
+        );
+    };
+};
+
+int main()
+{
+    char *errMsg;
+    int result;
+
+    result = SQLT::dropAllTables<cache_db>(&errMsg);
+    SQLT_ASSERT(result == SQLITE_OK);
+
+    sqlite3 *db;
+    result = SQLT::open<cache_db>(&db);
+    SQLT_ASSERT(result == SQLITE_OK);
+
+    result = SQLT::createAllTables<cache_db>(db, &errMsg);
+    SQLT_ASSERT(result == SQLITE_OK);
+
+    {
+        SQLT::StatementCache cache(db);
+        SQLT_ASSERT(cache.db() == db);
+        SQLT_ASSERT(cache.size() == 0);
+
+        result = SQLT::begin<cache_db>(db);
+        SQLT_ASSERT(result == SQLITE_OK);
+
+        // 1. Repeated inserts of small vectors prepare the INSERT statement once.
+        for (int i = 0; i < 100; i++)
+        {
+            std::vector<cache_db::Item> items({
+                { 2 * i,     "item" + std::to_string(2 * i),     { 0.5 * i } },
+                { 2 * i + 1, "item" + std::to_string(2 * i + 1), { /*NULL*/ } }
+            });
+            result = SQLT::insert(cache, items);
+            SQLT_ASSERT(result == SQLITE_OK);
+        }
+        SQLT_ASSERT(cache.misses() == 1);
+        SQLT_ASSERT(cache.hits() == 99);
+        SQLT_ASSERT(cache.size() == 1);
+
+        // 2. Statements are keyed by table type.
+        std::vector<cache_db::Tag> tags({ { 1, "a" }, { 1, "b" }, { 2, "a" } });
+        result = SQLT::insert(cache, tags);
+        SQLT_ASSERT(result == SQLITE_OK);
+        SQLT_ASSERT(cache.misses() == 2);
+        SQLT_ASSERT(cache.size() == 2);
+
+        // 3. A failing step leaves the cached statement usable.
+        result = SQLT::insert(cache, tags);
+        SQLT_ASSERT(result == SQLITE_CONSTRAINT);
+        std::vector<cache_db::Tag> moreTags({ { 3, "c" } });
+        result = SQLT::insert(cache, moreTags);
+        SQLT_ASSERT(result == SQLITE_OK);
+        SQLT_ASSERT(cache.misses() == 2);
+
+        result = SQLT::commit<cache_db>(db);
+        SQLT_ASSERT(result == SQLITE_OK);
+
+        // 4. selectAll and select(member) are cached as well.
+        for (int i = 0; i < 3; i++)
+        {
+            std::vector<cache_db::Item> items;
+            result = SQLT::selectAll(cache, &items);
+            SQLT_ASSERT(result == SQLITE_OK);
+            SQLT_ASSERT(items.size() == 200);
+            SQLT_ASSERT(items[3].id == 3 && items[3].name == "item3" && items[3].value.is_null);
+            SQLT_FUZZY_ASSERT(items[4].value.value, 1.0);
+
+            std::vector<std::string> names;
+            result = SQLT::select(cache, &cache_db::Item::name, &names);
+            SQLT_ASSERT(result == SQLITE_OK);
+            SQLT_ASSERT(names.size() == 200);
+            SQLT_ASSERT(names[199] == "item199");
+
+            std::vector<int> ids;
+            result = SQLT::select(cache, &cache_db::Item::id, &ids);
+            SQLT_ASSERT(result == SQLITE_OK);
+            SQLT_ASSERT(ids.size() == 200);
+            SQLT_ASSERT(ids[10] == 10);
+        }
+        SQLT_ASSERT(cache.misses() == 5);
+        SQLT_ASSERT(cache.size() == 5);
+
+        // 5. deleteAll through the cache.
+        result = SQLT::deleteAll<cache_db::Item>(cache);
+        SQLT_ASSERT(result == SQLITE_OK);
+        result = SQLT::deleteAll<cache_db::Item>(cache);
+        SQLT_ASSERT(result == SQLITE_OK);
+        SQLT_ASSERT(cache.misses() == 6);
+
+        std::vector<cache_db::Item> items;
+        result = SQLT::selectAll(cache, &items);
+        SQLT_ASSERT(result == SQLITE_OK);
+        SQLT_ASSERT(items.empty());
+
+        // 6. Batched inserts cache the full-size statement and insert the remainder with the cached INSERT statement.
+        size_t misses = cache.misses();
+        std::vector<cache_db::Item> batch;
+        for (int i = 0; i < 10; i++)
+            batch.push_back({ i, "batched" + std::to_string(i), { /*NULL*/ } });
+        result = SQLT::insertBatched(cache, batch, 4);
+        SQLT_ASSERT(result == SQLITE_OK);
+        SQLT_ASSERT(cache.misses() == misses + 1);
+
+        result = SQLT::selectAll(cache, &items);
+        SQLT_ASSERT(result == SQLITE_OK);
+        SQLT_ASSERT(items.size() == 10);
+        SQLT_ASSERT(items[9].id == 9 && items[9].name == "batched9");
+
+        result = SQLT::deleteAll<cache_db::Item>(cache);
+        SQLT_ASSERT(result == SQLITE_OK);
+        result = SQLT::insertBatched(cache, batch, 4);
+        SQLT_ASSERT(result == SQLITE_OK);
+        SQLT_ASSERT(cache.misses() == misses + 1);
+
+        // Any number of rows adds at most the statement for the full batch size.
+        const size_t cached = cache.size();
+        for (size_t count = 1; count <= batch.size(); count++)
+        {
+            result = SQLT::deleteAll<cache_db::Item>(cache);
+            SQLT_ASSERT(result == SQLITE_OK);
+            result = SQLT::insertBatched(cache, std::vector<cache_db::Item>(batch.begin(), batch.begin() + count), 3);
+            SQLT_ASSERT(result == SQLITE_OK);
+            SQLT_ASSERT(cache.size() <= cached + 1);
+        }
+        result = SQLT::selectAll(cache, &items);
+        SQLT_ASSERT(result == SQLITE_OK);
+        SQLT_ASSERT(items.size() == 10 + batch.size());
+
+        // 7. Custom queries with bound parameters are cached by their SQL text.
+        misses = cache.misses();
+        for (int i = 0; i < 10; i++)
+        {
+            result = SQLT::query(cache, "UPDATE Item SET name = ?, value = ? WHERE id = ?;", std::string("renamed"), SQLT::Nullable<double>(i * 2.0), i);
+            SQLT_ASSERT(result == SQLITE_OK);
+        }
+        SQLT_ASSERT(cache.misses() == misses + 1);
+
+        for (int i = 0; i < 3; i++)
+        {
+            std::vector<cache_db::ItemName> names;
+            result = SQLT::select(cache, "SELECT id, name FROM Item WHERE id >= ? AND name = ? ORDER BY id;", &names, SQLT::params(5, "renamed"));
+            SQLT_ASSERT(result == SQLITE_OK);
+            SQLT_ASSERT(names.size() == 5);
+            SQLT_ASSERT(names[0].id == 5 && names[4].id == 9);
+        }
+        SQLT_ASSERT(cache.misses() == misses + 2);
+
+        // A NULL parameter, and a query without parameters.
+        result = SQLT::query(cache, "UPDATE Item SET value = ? WHERE id = ?;", SQLT::Nullable<double>(), int64_t(3));
+        SQLT_ASSERT(result == SQLITE_OK);
+        result = SQLT::query(cache, "DELETE FROM Item WHERE value IS NULL;");
+        SQLT_ASSERT(result == SQLITE_OK);
+
+        // 8. Clearing finalizes the statements but keeps the counters.
+        size_t hits = cache.hits();
+        cache.clear();
+        SQLT_ASSERT(cache.size() == 0);
+        SQLT_ASSERT(cache.hits() == hits);
+    }
+
+    // 9. Bound parameters without a cache.
+    result = SQLT::query(db, "INSERT INTO Item VALUES(?, ?, ?);", 100, "uncached", SQLT::Nullable<double>(1.5));
+    SQLT_ASSERT(result == SQLITE_OK);
+    std::vector<cache_db::ItemName> names;
+    result = SQLT::select(db, "SELECT id, name FROM Item WHERE value > ?;", &names, SQLT::params(1.0));
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(names.size() == 9);
+    SQLT_ASSERT(names[8].id == 100 && names[8].name == "uncached");
+    result = SQLT::query(db, "INSERT INTO Item VALUES(?, ?, ?);", 100, "duplicate", SQLT::Nullable<double>());
+    SQLT_ASSERT(result == SQLITE_CONSTRAINT);
+
+    // 10. Integers of other types than int are bound as 64-bit integers, and floats as doubles.
+    const long long bigId = 5000000000LL;
+    result = SQLT::query(db, "INSERT INTO Tag VALUES(?, ?);", size_t(101), "unsigned");
+    SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::query(db, "INSERT INTO Tag VALUES(?, ?);", bigId, "long long");
+    SQLT_ASSERT(result == SQLITE_OK);
+    std::vector<cache_db::Tag> tags;
+    result = SQLT::select(db, "SELECT item_id, tag FROM Tag WHERE item_id = ? OR item_id >= ? ORDER BY item_id;", &tags, SQLT::params(101u, bigId));
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(tags.size() == 2 && tags[0].item_id == 101 && tags[0].tag == "unsigned" && tags[1].tag == "long long");
+    names.clear();
+    result = SQLT::select(db, "SELECT id, name FROM Item WHERE value > ?;", &names, SQLT::params(1.0f));
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(names.size() == 9);
+
+    // All cached statements are finalized, so the connection can be closed.
+    result = SQLT::close<cache_db>(db);
+    SQLT_ASSERT(result == SQLITE_OK);
+
+    return 0;
+}
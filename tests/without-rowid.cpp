@@ -0,0 +1,198 @@
+#include "assert.h"
+
+#include <sqlite3/sqlite3.h>
+#include <sqlite_tools.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// The same link table, stored as a rowid table with a primary key index and as a table without rowid.
+struct rowid_db
+{
+    struct Link
+    {
+        int left_id;
+        int right_id;
+
+        SQLT_TABLE(Link,
+            SQLT_COLUMN_PRIMARY_KEY(left_id),
+            SQLT_COLUMN_PRIMARY_KEY(right_id)
+        );
+    };
+
+    SQLT_DATABASE_WITH_NAME(rowid_db, "rowid_db.sqlite",
+        SQLT_DATABASE_TABLE(Link)
+    );
+};
+
+struct without_rowid_db
+{
+    struct Link
+    {
+        int left_id;
+        int right_id;
+
+        SQLT_TABLE_WITHOUT_ROWID(Link,
+            SQLT_COLUMN_PRIMARY_KEY(left_id),
+            SQLT_COLUMN_PRIMARY_KEY(right_id)
+        );
+    };
+
+    SQLT_DATABASE_WITH_NAME(without_rowid_db, "without_rowid_db.sqlite",
+        SQLT_DATABASE_TABLE(Link)
+    );
+};
+
+struct TableSql
+{
+    std::string sql;
+
+    SQLT_QUERY_RESULT_STRUCT(TableSql,
+        SQLT_QUERY_RESULT_MEMBER(sql)
+    );
+};
+
+struct LinkStats
+{
+    long long fileSize;
+    long long insertMilliseconds;
+    long long lookupMilliseconds;
+};
+
+long long pragmaValue(sqlite3 *db, const char *pragma)
+{
+    sqlite3_stmt *stmt;
+    int result = sqlite3_prepare_v2(db, pragma, -1, &stmt, NULL);
+    SQLT_ASSERT(result == SQLITE_OK);
+    result = sqlite3_step(stmt);
+    SQLT_ASSERT(result == SQLITE_ROW);
+    long long value = sqlite3_column_int64(stmt, 0);
+    sqlite3_finalize(stmt);
+    return value;
+}
+
+template<typename SQLT_DB, typename LINK>
+LinkStats measure(const std::vector<std::pair<int, int>>& pairs, const std::vector<std::pair<int, int>>& lookups)
+{
+    char *errMsg;
+    int result;
+    sqlite3 *db;
+    LinkStats stats;
+
+    result = SQLT::dropAllTables<SQLT_DB>(&errMsg);        SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::open<SQLT_DB>(&db);                     SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::createAllTables<SQLT_DB>(db, &errMsg);  SQLT_ASSERT(result == SQLITE_OK);
+
+    std::vector<LINK> links;
+    links.reserve(pairs.size());
+    for (const auto& pair : pairs)
+        links.push_back({ pair.first, pair.second });
+
+    auto start = std::chrono::steady_clock::now();
+    result = SQLT::begin<SQLT_DB>(db);                     SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::insert(db, links);                      SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::commit<SQLT_DB>(db);                    SQLT_ASSERT(result == SQLITE_OK);
+    auto end = std::chrono::steady_clock::now();
+    stats.insertMilliseconds = (long long)std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+
+    stats.fileSize = pragmaValue(db, "PRAGMA page_count;") * pragmaValue(db, "PRAGMA page_size;");
+
+    sqlite3_stmt *stmt;
+    result = sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM Link WHERE left_id = ? AND right_id = ?;", -1, &stmt, NULL);
+    SQLT_ASSERT(result == SQLITE_OK);
+    int found = 0;
+    start = std::chrono::steady_clock::now();
+    for (const auto& lookup : lookups)
+    {
+        sqlite3_reset(stmt);
+        sqlite3_bind_int(stmt, 1, lookup.first);
+        sqlite3_bind_int(stmt, 2, lookup.second);
+        result = sqlite3_step(stmt);
+        SQLT_ASSERT(result == SQLITE_ROW);
+        found += sqlite3_column_int(stmt, 0);
+    }
+    end = std::chrono::steady_clock::now();
+    stats.lookupMilliseconds = (long long)std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+    sqlite3_finalize(stmt);
+    SQLT_ASSERT(found == (int)lookups.size());
+
+    result = SQLT::close<SQLT_DB>(db);                     SQLT_ASSERT(result == SQLITE_OK);
+    return stats;
+}
+
+void testDeclaration()
+{
+    char *errMsg;
+    int result;
+    sqlite3 *db;
+
+    result = SQLT::dropAllTables<without_rowid_db>(&errMsg);        SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::open<without_rowid_db>(&db);                     SQLT_ASSERT(result == SQLITE_OK);
+    result = SQLT::createAllTables<without_rowid_db>(db, &errMsg);  SQLT_ASSERT(result == SQLITE_OK);
+
+    // 1. The table is created WITHOUT ROWID, and only for the tables declared so.
+    std::vector<TableSql> tableSql;
+    result = SQLT::select(db, "SELECT sql FROM sqlite_master WHERE type = 'table' AND name = 'Link';", &tableSql, 1);
+    SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(tableSql.size() == 1);
+    SQLT_ASSERT(tableSql[0].sql.find("WITHOUT ROWID") != std::string::npos);
+    SQLT_ASSERT(SQLT::Internal::withoutRowid<without_rowid_db::Link>());
+    SQLT_ASSERT(!SQLT::Internal::withoutRowid<rowid_db::Link>());
+
+    // 2. Rows are stored in primary key order.
+    std::vector<without_rowid_db::Link> links({ { 2, 1 }, { 1, 2 }, { 1, 1 } });
+    result = SQLT::insert(db, links);                      SQLT_ASSERT(result == SQLITE_OK);
+    std::vector<without_rowid_db::Link> selected;
+    result = SQLT::selectAll(db, &selected);               SQLT_ASSERT(result == SQLITE_OK);
+    SQLT_ASSERT(selected.size() == 3);
+    SQLT_ASSERT(selected[0].left_id == 1 && selected[0].right_id == 1);
+    SQLT_ASSERT(selected[2].left_id == 2 && selected[2].right_id == 1);
+
+    // 3. There are no rowids to return.
+    std::vector<int64_t> ids;
+    result = SQLT::insertReturningIds(db, std::vector<without_rowid_db::Link>({ { 3, 3 } }), &ids);
+    SQLT_ASSERT(result == SQLITE_MISUSE);
+    SQLT_ASSERT(ids.empty());
+
+    result = SQLT::close<without_rowid_db>(db);            SQLT_ASSERT(result == SQLITE_OK);
+}
+
+int main()
+{
+    static const int LEFT_COUNT = 1000;
+    static const int RIGHT_COUNT = 200;
+    static const int LOOKUP_COUNT = 200000;
+    srand(9157);
+
+    testDeclaration();
+
+    // Every left id links to every right id, in random order.
+    std::vector<std::pair<int, int>> pairs;
+    pairs.reserve(LEFT_COUNT * RIGHT_COUNT);
+    for (int left = 0; left < LEFT_COUNT; left++)
+        for (int right = 0; right < RIGHT_COUNT; right++)
+            pairs.push_back(std::make_pair(left, right));
+    for (size_t i = pairs.size() - 1; i > 0; i--)
+        std::swap(pairs[i], pairs[rand() % (i + 1)]);
+
+    std::vector<std::pair<int, int>> lookups;
+    lookups.reserve(LOOKUP_COUNT);
+    for (int i = 0; i < LOOKUP_COUNT; i++)
+        lookups.push_back(pairs[rand() % pairs.size()]);
+
+    LinkStats rowid = measure<rowid_db, rowid_db::Link>(pairs, lookups);
+    fprintf(stderr, "Rowid table: %lld bytes, %d rows inserted in %lld milliseconds, %d lookups in %lld milliseconds.\n",
+            rowid.fileSize, (int)pairs.size(), rowid.insertMilliseconds, LOOKUP_COUNT, rowid.lookupMilliseconds);
+
+    LinkStats withoutRowid = measure<without_rowid_db, without_rowid_db::Link>(pairs, lookups);
+    fprintf(stderr, "Table without rowid: %lld bytes, %d rows inserted in %lld milliseconds, %d lookups in %lld milliseconds.\n",
+            withoutRowid.fileSize, (int)pairs.size(), withoutRowid.insertMilliseconds, LOOKUP_COUNT, withoutRowid.lookupMilliseconds);
+
+    // The primary key index of the rowid table holds the same data as the table without rowid.
+    SQLT_ASSERT(withoutRowid.fileSize < rowid.fileSize);
+
+    return 0;
+}